@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+//
+// Compares the per start/stop overhead of the default hierarchical insertion path of
+// tim::storage against the dense call-graph index enabled via
+// tim::trait::dense_call_graph. Both components are identical except for the trait.
+//
+
+#include "timemory/mpl/macros.hpp"
+#include "timemory/mpl/types.hpp"
+
+#include "timemory/components/base.hpp"
+#include "timemory/components/timing/wall_clock.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+template <size_t Idx>
+struct insert_clock : public tim::component::base<insert_clock<Idx>, int64_t>
+{
+    using ratio_t    = std::nano;
+    using value_type = int64_t;
+    using this_type  = insert_clock<Idx>;
+    using base_type  = tim::component::base<this_type, value_type>;
+
+    using base_type::accum;
+    using base_type::load;
+    using base_type::value;
+
+    static std::string label() { return "insert_clock_" + std::to_string(Idx); }
+    static std::string description() { return "wall time"; }
+    static int64_t     unit() { return tim::component::wall_clock::unit(); }
+    static std::string display_unit() { return tim::component::wall_clock::display_unit(); }
+    static value_type  record() { return tim::component::wall_clock::record(); }
+
+    double get() const { return load() / static_cast<double>(base_type::get_unit()); }
+    double get_display() const { return get(); }
+
+    void start() { value = record(); }
+    void stop()
+    {
+        auto tmp = record();
+        accum += (tmp - value);
+        value = tmp;
+    }
+};
+
+using default_clock = insert_clock<0>;
+using dense_clock   = insert_clock<1>;
+
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_timing_category, default_clock, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_timing_category, dense_clock, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_timing_units, default_clock, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_timing_units, dense_clock, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(dense_call_graph, dense_clock, true_type)
+
+#include "timemory/timemory.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using clock_type    = std::chrono::steady_clock;
+using duration_type = std::chrono::duration<double, std::nano>;
+
+//--------------------------------------------------------------------------------------//
+//  walks a call-tree of the given depth and breadth so that every iteration
+//  re-enters existing call-paths
+//
+template <typename BundleT>
+void
+walk(const std::vector<std::string>& _labels, int _depth, int _breadth)
+{
+    if(_depth == 0)
+        return;
+    for(int i = 0; i < _breadth; ++i)
+    {
+        BundleT _bundle{ _labels.at(i) };
+        _bundle.start();
+        walk<BundleT>(_labels, _depth - 1, _breadth);
+        _bundle.stop();
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+template <typename Tp>
+double
+run(const std::vector<std::string>& _labels, int _nitr, int _depth, int _breadth)
+{
+    using bundle_t = tim::component_bundle<TIMEMORY_API, Tp>;
+
+    // warmup: creates all the call-graph entries
+    walk<bundle_t>(_labels, _depth, _breadth);
+
+    int64_t _count = 0;
+    for(int d = 1, n = _breadth; d <= _depth; ++d, n *= _breadth)
+        _count += n;
+
+    auto _beg = clock_type::now();
+    for(int i = 0; i < _nitr; ++i)
+        walk<bundle_t>(_labels, _depth, _breadth);
+    auto _end = clock_type::now();
+
+    auto _nsec = std::chrono::duration_cast<duration_type>(_end - _beg).count();
+    auto _per  = _nsec / static_cast<double>(_count * _nitr);
+    std::cout << std::setw(16) << Tp::label() << " : " << std::setw(10) << std::fixed
+              << std::setprecision(2) << _per << " nsec per start/stop ("
+              << tim::storage<Tp>::instance()->size() << " call-graph entries)"
+              << std::endl;
+    return _per;
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    tim::settings::destructor_report() = false;
+    tim::settings::file_output()       = false;
+    tim::settings::cout_output()       = false;
+    tim::timemory_init(argc, argv);
+
+    int nitr    = (argc > 1) ? std::stoi(argv[1]) : 1000;
+    int depth   = (argc > 2) ? std::stoi(argv[2]) : 6;
+    int breadth = (argc > 3) ? std::stoi(argv[3]) : 4;
+
+    std::vector<std::string> labels{};
+    for(int i = 0; i < breadth; ++i)
+        labels.emplace_back("region_" + std::to_string(i));
+
+    std::cout << "\nRunning " << nitr << " iterations of call-tree with depth = " << depth
+              << " and breadth = " << breadth << "...\n"
+              << std::endl;
+
+    auto _default = run<default_clock>(labels, nitr, depth, breadth);
+    auto _dense   = run<dense_clock>(labels, nitr, depth, breadth);
+
+    std::cout << "\n" << std::setw(16) << "speed-up" << " : " << std::setw(10)
+              << std::setprecision(2) << (_default / _dense) << "x\n" << std::endl;
+
+    auto _default_size = tim::storage<default_clock>::instance()->size();
+    auto _dense_size   = tim::storage<dense_clock>::instance()->size();
+
+    tim::timemory_finalize();
+
+    if(_default_size != _dense_size)
+    {
+        fprintf(stderr, "Error! call-graph sizes differ: %zu vs. %zu\n", _default_size,
+                _dense_size);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
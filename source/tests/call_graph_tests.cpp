@@ -0,0 +1,264 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "test_macros.hpp"
+
+TIMEMORY_TEST_DEFAULT_MAIN
+
+#include "timemory/components/base.hpp"
+#include "timemory/components/timing/wall_clock.hpp"
+#include "timemory/mpl/macros.hpp"
+#include "timemory/mpl/types.hpp"
+
+#include <cstdint>
+#include <string>
+
+// identical components except for the dense_call_graph trait
+template <size_t Idx>
+struct call_graph_clock : public tim::component::base<call_graph_clock<Idx>, int64_t>
+{
+    using ratio_t    = std::nano;
+    using value_type = int64_t;
+    using this_type  = call_graph_clock<Idx>;
+    using base_type  = tim::component::base<this_type, value_type>;
+
+    using base_type::accum;
+    using base_type::load;
+    using base_type::value;
+
+    static std::string label() { return "call_graph_clock_" + std::to_string(Idx); }
+    static std::string description() { return "wall time"; }
+    static int64_t     unit() { return tim::component::wall_clock::unit(); }
+    static std::string display_unit() { return tim::component::wall_clock::display_unit(); }
+    static value_type  record() { return tim::component::wall_clock::record(); }
+
+    double get() const { return load() / static_cast<double>(base_type::get_unit()); }
+    double get_display() const { return get(); }
+
+    void start() { value = record(); }
+    void stop()
+    {
+        auto tmp = record();
+        accum += (tmp - value);
+        value = tmp;
+    }
+};
+
+using default_clock = call_graph_clock<0>;
+using dense_clock   = call_graph_clock<1>;
+
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_timing_units, default_clock, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_timing_units, dense_clock, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(dense_call_graph, dense_clock, true_type)
+
+#include "timemory/timemory.hpp"
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+//--------------------------------------------------------------------------------------//
+
+namespace details
+{
+//--------------------------------------------------------------------------------------//
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return std::string(::testing::UnitTest::GetInstance()->current_test_suite()->name()) +
+           "." + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+template <typename Tp>
+using bundle_t = tim::component_bundle<TIMEMORY_API, Tp>;
+
+// walks a call-tree of the given depth and breadth
+template <typename Tp>
+void
+walk(int _depth, int _breadth, tim::scope::config _scope = tim::scope::get_default())
+{
+    if(_depth == 0)
+        return;
+    for(int i = 0; i < _breadth; ++i)
+    {
+        bundle_t<Tp> _bundle{ "walk_" + std::to_string(i), _scope };
+        _bundle.start();
+        walk<Tp>(_depth - 1, _breadth, _scope);
+        _bundle.stop();
+    }
+}
+
+// recursion with the same label at every level
+template <typename Tp>
+long
+fibonacci(long n)
+{
+    bundle_t<Tp> _bundle{ "fibonacci" };
+    _bundle.start();
+    auto _ret = (n < 2) ? n : (fibonacci<Tp>(n - 1) + fibonacci<Tp>(n - 2));
+    _bundle.stop();
+    return _ret;
+}
+
+// worker threads which start while the master thread is inside a region
+template <typename Tp>
+void
+threaded(int _nthreads, int _nitr)
+{
+    bundle_t<Tp> _bundle{ "threaded" };
+    _bundle.start();
+    std::vector<std::thread> _threads{};
+    for(int i = 0; i < _nthreads; ++i)
+    {
+        _threads.emplace_back([_nitr]() {
+            for(int j = 0; j < _nitr; ++j)
+                walk<Tp>(2, 2);
+        });
+    }
+    for(auto& itr : _threads)
+        itr.join();
+    _bundle.stop();
+}
+
+template <typename Tp>
+void
+reset()
+{
+    tim::storage<Tp>::instance()->reset();
+}
+
+template <typename Tp>
+auto
+get()
+{
+    return tim::storage<Tp>::instance()->get();
+}
+
+// compares the label, depth, and laps of every entry in the call-graph
+template <typename FuncT>
+void
+compare(FuncT&& _func)
+{
+    reset<default_clock>();
+    reset<dense_clock>();
+
+    _func(default_clock{});
+    _func(dense_clock{});
+
+    auto _default = get<default_clock>();
+    auto _dense   = get<dense_clock>();
+
+    ASSERT_FALSE(_default.empty()) << get_test_name();
+    ASSERT_EQ(_default.size(), _dense.size()) << get_test_name();
+    for(size_t i = 0; i < _default.size(); ++i)
+    {
+        const auto& _lhs = _default.at(i);
+        const auto& _rhs = _dense.at(i);
+        EXPECT_EQ(_lhs.prefix(), _rhs.prefix()) << get_test_name() << " @ " << i;
+        EXPECT_EQ(_lhs.depth(), _rhs.depth()) << get_test_name() << " @ " << i;
+        EXPECT_EQ(_lhs.data().get_laps(), _rhs.data().get_laps())
+            << get_test_name() << " @ " << i << " :: " << _lhs.prefix();
+    }
+}
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class call_graph_tests : public ::testing::Test
+{
+protected:
+    TIMEMORY_TEST_DEFAULT_SUITE_BODY
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(call_graph_tests, hierarchy)
+{
+    details::compare([](auto _v) {
+        using type = decltype(_v);
+        for(int i = 0; i < 5; ++i)
+            details::walk<type>(4, 3);
+    });
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(call_graph_tests, recursion)
+{
+    details::compare([](auto _v) {
+        using type = decltype(_v);
+        for(int i = 0; i < 3; ++i)
+            details::fibonacci<type>(8);
+    });
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(call_graph_tests, threads)
+{
+    details::compare([](auto _v) {
+        using type = decltype(_v);
+        details::threaded<type>(4, 3);
+        details::walk<type>(2, 2);
+    });
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(call_graph_tests, flat)
+{
+    details::compare([](auto _v) {
+        using type = decltype(_v);
+        for(int i = 0; i < 3; ++i)
+        {
+            details::bundle_t<type> _bundle{ "flat_parent" };
+            _bundle.start();
+            details::walk<type>(3, 2, tim::scope::flat{});
+            details::walk<type>(2, 2);
+            _bundle.stop();
+        }
+    });
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(call_graph_tests, reset)
+{
+    details::compare([](auto _v) {
+        using type = decltype(_v);
+        details::walk<type>(3, 3);
+        details::reset<type>();
+        details::walk<type>(2, 3);
+        details::walk<type>(3, 2);
+    });
+
+    // only the entries from the re-insertion: walk(2, 3) creates 3 + 9 entries and
+    // walk(3, 2) creates 2 + 4 + 8 entries of which 2 + 4 already exist
+    auto _default = tim::storage<default_clock>::instance()->get();
+    EXPECT_EQ(_default.size(), (3 + 9) + (2 + 4 + 8) - (2 + 4));
+}
+
+//--------------------------------------------------------------------------------------//
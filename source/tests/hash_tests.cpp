@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "test_macros.hpp"
+
+TIMEMORY_TEST_DEFAULT_MAIN
+
+#include "timemory/hash.hpp"
+#include "timemory/timemory.hpp"
+
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//--------------------------------------------------------------------------------------//
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return std::string(::testing::UnitTest::GetInstance()->current_test_suite()->name()) +
+           "." + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class hash_tests : public ::testing::Test
+{
+protected:
+    TIMEMORY_TEST_DEFAULT_SUITE_BODY
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(hash_tests, flat_map_insert)
+{
+    tim::hash::flat_map<std::string> _map{};
+    std::vector<std::string>         _labels{};
+    for(int i = 0; i < 1000; ++i)
+        _labels.emplace_back(details::get_test_name() + "/" + std::to_string(i));
+
+    for(const auto& itr : _labels)
+        EXPECT_TRUE(_map.emplace(tim::get_hash_id(itr), itr).second);
+    for(const auto& itr : _labels)
+        EXPECT_FALSE(_map.emplace(tim::get_hash_id(itr), itr).second);
+
+    EXPECT_EQ(_map.size(), _labels.size());
+    for(const auto& itr : _labels)
+    {
+        auto mitr = _map.find(tim::get_hash_id(itr));
+        ASSERT_NE(mitr, _map.end());
+        EXPECT_EQ(mitr->second, itr);
+        EXPECT_EQ(_map.count(tim::get_hash_id(itr)), 1);
+    }
+    EXPECT_EQ(_map.find(0), _map.end());
+    EXPECT_EQ(_map.count(0), 0);
+
+    // iteration follows insertion order
+    size_t _n = 0;
+    for(const auto& itr : _map)
+        EXPECT_EQ(itr.second, _labels.at(_n++));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(hash_tests, flat_map_stable_references)
+{
+    tim::hash::flat_map<std::string> _map{};
+    auto                             _key = tim::get_hash_id(details::get_test_name());
+    auto* _ptr = &_map.emplace(_key, details::get_test_name()).first->second;
+
+    // force the probe table to grow several times
+    for(uint64_t i = 1; i < 4096; ++i)
+        _map.emplace(i << 12, std::to_string(i));
+
+    EXPECT_EQ(_ptr, &_map.at(_key));
+    EXPECT_EQ(*_ptr, details::get_test_name());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(hash_tests, flat_map_merge)
+{
+    tim::hash::flat_map<tim::hash_value_t> _lhs{};
+    tim::hash::flat_map<tim::hash_value_t> _rhs{};
+
+    for(tim::hash_value_t i = 0; i < 100; ++i)
+        _lhs.emplace(i, i);
+    for(tim::hash_value_t i = 50; i < 200; ++i)
+        _rhs.emplace(i, 2 * i);
+
+    _lhs.merge(_rhs);
+
+    EXPECT_EQ(_lhs.size(), 200);
+    for(tim::hash_value_t i = 0; i < 200; ++i)
+    {
+        // existing entries are not replaced
+        auto _expected = (i < 100) ? i : 2 * i;
+        EXPECT_EQ(_lhs.at(i), _expected) << "key: " << i;
+    }
+
+    _lhs.merge(_lhs);
+    EXPECT_EQ(_lhs.size(), 200);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(hash_tests, registry)
+{
+    auto _name  = details::get_test_name();
+    auto _hash  = tim::add_hash_id(_name);
+    auto _alias = tim::get_combined_hash_id(_hash, 1);
+    tim::add_hash_id(_hash, _alias);
+
+    EXPECT_EQ(tim::get_hash_identifier(_hash), _name);
+    EXPECT_EQ(tim::get_hash_identifier(_alias), _name);
+    EXPECT_EQ(tim::get_hash_id(tim::get_hash_aliases(), _alias), _hash);
+}
+
+//--------------------------------------------------------------------------------------//
@@ -453,6 +453,77 @@ TEST_F(mpi_tests, vector_get)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(mpi_tests, collapse)
+{
+    using mpi_get_t = tim::operation::finalize::mpi_get<wall_clock, true>;
+    static_assert(mpi_get_t::flat_layout, "wall_clock should use the flat binary layout");
+
+    for(int i = 0; i < 4; ++i)
+    {
+        tim::auto_tuple<wall_clock> _parent{ details::get_test_name() };
+        tim::auto_tuple<wall_clock> _child{ TIMEMORY_JOIN("/", details::get_test_name(),
+                                                          i % 2) };
+    }
+
+    // number of records and laps for this test
+    using count_t  = std::pair<int64_t, int64_t>;
+    auto _get_laps = [](const auto& _data) {
+        auto _ret = count_t{ 0, 0 };
+        for(const auto& itr : _data)
+        {
+            if(itr.prefix().find(details::get_test_name()) == std::string::npos)
+                continue;
+            _ret.first += 1;
+            _ret.second += itr.data().get_laps();
+        }
+        return _ret;
+    };
+
+    auto* _storage   = tim::storage<wall_clock>::instance();
+    auto  _local     = _storage->get();
+    auto  _gathered  = mpi_get_t::distrib_type{};
+    auto  _collapsed = mpi_get_t::distrib_type{};
+
+    mpi_get_t{ *_storage, false, 0 }(_gathered);
+    mpi_get_t{ *_storage, true, 1 }(_collapsed);
+
+    EXPECT_EQ(_get_laps(_local), count_t(3, 8));
+
+    if(tim::mpi::rank() == 0)
+    {
+        ASSERT_EQ(_gathered.size(), tim::mpi::size());
+        for(const auto& itr : _gathered)
+        {
+            EXPECT_EQ(itr.size(), _local.size());
+            EXPECT_EQ(_get_laps(itr), _get_laps(_local));
+        }
+
+        // the tree reduction should be identical to merging the ranks in order
+        auto _expected = mpi_get_t::result_type{};
+        for(auto& itr : _gathered)
+            tim::operation::finalize::merge<wall_clock, true>(_expected, itr);
+
+        ASSERT_EQ(_collapsed.size(), 1);
+        ASSERT_EQ(_collapsed.front().size(), _expected.size());
+        for(size_t i = 0; i < _expected.size(); ++i)
+        {
+            EXPECT_EQ(_collapsed.front().at(i).prefix(), _expected.at(i).prefix());
+            EXPECT_EQ(_collapsed.front().at(i).data().get_laps(),
+                      _expected.at(i).data().get_laps());
+        }
+        EXPECT_EQ(_get_laps(_collapsed.front()).second, 8 * tim::mpi::size());
+    }
+    else
+    {
+        ASSERT_EQ(_gathered.size(), 1);
+        ASSERT_EQ(_collapsed.size(), 1);
+        EXPECT_EQ(_get_laps(_gathered.front()), _get_laps(_local));
+        EXPECT_EQ(_get_laps(_collapsed.front()), _get_laps(_local));
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
 TEST_F(mpi_tests, send_recv_overflow)
 {
     namespace comp   = tim::component;
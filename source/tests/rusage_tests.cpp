@@ -289,3 +289,35 @@ TEST_F(rusage_tests, current_peak_rss)
 }
 
 //--------------------------------------------------------------------------------------//
+
+TEST_F(rusage_tests, procfs_coalesce)
+{
+#if defined(TIMEMORY_LINUX)
+    using coalesce_t = tim::procfs::scoped_coalesce<>;
+    static_assert(tim::procfs::uses_file_sampler<page_rss, wall_clock>::value,
+                  "page_rss should coalesce reads");
+    static_assert(!tim::procfs::uses_file_sampler<tim::type_list<wall_clock>>::value,
+                  "wall_clock should not coalesce reads");
+
+    auto _page = tim::units::get_page_size();
+    EXPECT_GT(tim::get_page_rss(), 0);
+    EXPECT_EQ(tim::get_page_rss() % _page, 0);
+
+    int64_t _beg = 0;
+    int64_t _end = 0;
+    {
+        coalesce_t _coalesce{};
+        _beg = tim::get_page_rss();
+        // touching new pages is not visible until the scope ends
+        std::vector<int64_t> _data(nelements * 4, 1);
+        _end = tim::get_page_rss();
+        EXPECT_EQ(_beg, _end) << "data size: " << _data.size();
+        _data.clear();
+    }
+    std::vector<int64_t> _data(nelements * 4, 1);
+    _end = tim::get_page_rss();
+    EXPECT_GT(_end, _beg) << "data size: " << _data.size();
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
@@ -0,0 +1,292 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "test_macros.hpp"
+
+TIMEMORY_TEST_DEFAULT_MAIN
+
+#include "timemory/components/base.hpp"
+#include "timemory/data/statistics.hpp"
+#include "timemory/macros.hpp"
+#include "timemory/mpl/macros.hpp"
+#include "timemory/mpl/types.hpp"
+
+#include <cstdint>
+#include <string>
+
+// records the value assigned to next() when stopped
+struct sample_value : public tim::component::base<sample_value, double>
+{
+    using value_type = double;
+    using this_type  = sample_value;
+    using base_type  = tim::component::base<this_type, value_type>;
+
+    using base_type::accum;
+    using base_type::load;
+    using base_type::value;
+
+    static std::string label() { return "sample_value"; }
+    static std::string description() { return "recorded sample"; }
+    static double&     next()
+    {
+        static thread_local double _v = 0.0;
+        return _v;
+    }
+
+    double get() const { return load(); }
+    double get_display() const { return get(); }
+
+    void start() {}
+    void stop()
+    {
+        value = next();
+        accum += next();
+    }
+};
+
+TIMEMORY_STATISTICS_TYPE(sample_value, double)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(record_statistics, sample_value, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(record_quantiles, sample_value, true_type)
+
+#include "timemory/timemory.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+//--------------------------------------------------------------------------------------//
+
+namespace details
+{
+//--------------------------------------------------------------------------------------//
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return std::string(::testing::UnitTest::GetInstance()->current_test_suite()->name()) +
+           "." + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// exact value at the quantile of a sorted array
+inline double
+get_quantile(const std::vector<double>& _data, double _q)
+{
+    return _data.at(static_cast<size_t>(_q * (_data.size() - 1)));
+}
+
+// relative difference
+inline double
+get_error(double _lhs, double _rhs)
+{
+    return std::abs(_lhs - _rhs) / std::abs(_rhs);
+}
+
+// lognormal samples, e.g. latencies
+inline std::vector<double>
+generate(size_t _n, uint64_t _seed)
+{
+    std::mt19937_64                  _rng{ _seed };
+    std::lognormal_distribution<double> _dist{ 0.0, 1.0 };
+    std::vector<double>              _data(_n);
+    for(auto& itr : _data)
+        itr = _dist(_rng);
+    return _data;
+}
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class statistics_tests : public ::testing::Test
+{
+protected:
+    TIMEMORY_TEST_DEFAULT_SUITE_BODY
+};
+
+using quantile_t = tim::quantile_statistics<double>;
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, policy)
+{
+    using stats_t = typename tim::policy::record_statistics<sample_value>::statistics_type;
+    static_assert(std::is_same<stats_t, quantile_t>::value,
+                  "record_quantiles should select quantile_statistics");
+    using wall_t = typename tim::policy::record_statistics<
+        tim::component::wall_clock>::statistics_type;
+    static_assert(!std::is_same<wall_t, tim::quantile_statistics<double>>::value,
+                  "record_quantiles should be opt-in");
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, accuracy)
+{
+    auto       _data = details::generate(100000, 1);
+    quantile_t _stats{};
+    for(const auto& itr : _data)
+        _stats += itr;
+    std::sort(_data.begin(), _data.end());
+
+    EXPECT_EQ(_stats.get_count(), _data.size());
+    EXPECT_EQ(_stats.get_sketch_count(), _data.size());
+    EXPECT_LE(_stats.get_buckets().size(), quantile_t::max_buckets);
+    for(double _q : { 0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0 })
+    {
+        EXPECT_LE(details::get_error(_stats.get_quantile(_q),
+                                     details::get_quantile(_data, _q)),
+                  quantile_t::relative_accuracy)
+            << "quantile: " << _q;
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, merge)
+{
+    auto       _lhs_data = details::generate(50000, 2);
+    auto       _rhs_data = details::generate(50000, 3);
+    quantile_t _lhs{};
+    quantile_t _rhs{};
+    quantile_t _all{};
+    for(const auto& itr : _lhs_data)
+    {
+        _lhs += itr;
+        _all += itr;
+    }
+    for(const auto& itr : _rhs_data)
+    {
+        _rhs += itr;
+        _all += itr;
+    }
+
+    auto _merged = _lhs + _rhs;
+    EXPECT_EQ(_merged.get_count(), _all.get_count());
+    EXPECT_EQ(_merged.get_buckets(), _all.get_buckets());
+    for(double _q : { 0.5, 0.99, 0.999 })
+        EXPECT_DOUBLE_EQ(_merged.get_quantile(_q), _all.get_quantile(_q));
+
+    // the sketch is scaled lazily
+    auto _scaled = _merged;
+    _scaled *= 1000.0;
+    EXPECT_EQ(_scaled.get_buckets(), _merged.get_buckets());
+    EXPECT_NEAR(_scaled.get_quantile(0.99), 1000.0 * _merged.get_quantile(0.99),
+                1.0e-6 * _scaled.get_quantile(0.99));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, collapse)
+{
+    // values spanning 18 orders of magnitude exceed the bucket limit
+    quantile_t          _stats{};
+    std::vector<double> _data{};
+    for(int i = -9; i < 9; ++i)
+    {
+        for(int j = 1; j <= 100; ++j)
+        {
+            _data.emplace_back(std::pow(10.0, i) * j);
+            _stats += _data.back();
+        }
+    }
+    _stats += 0.0;
+    _data.emplace_back(0.0);
+    std::sort(_data.begin(), _data.end());
+
+    EXPECT_EQ(_stats.get_buckets().size(), quantile_t::max_buckets);
+    EXPECT_EQ(_stats.get_sketch_count(), _data.size());
+    EXPECT_DOUBLE_EQ(_stats.get_quantile(0.0), 0.0);
+    // only the lowest values lose accuracy
+    for(double _q : { 0.9, 0.99, 0.999, 1.0 })
+    {
+        EXPECT_LE(details::get_error(_stats.get_quantile(_q),
+                                     details::get_quantile(_data, _q)),
+                  quantile_t::relative_accuracy)
+            << "quantile: " << _q;
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, storage)
+{
+    using bundle_t = tim::component_bundle<TIMEMORY_API, sample_value>;
+
+    std::vector<double> _data{};
+    for(int i = 1; i <= 1000; ++i)
+    {
+        sample_value::next() = i;
+        _data.emplace_back(i);
+        bundle_t _bundle{ details::get_test_name() };
+        _bundle.start();
+        _bundle.stop();
+    }
+
+    auto _results = tim::storage<sample_value>::instance()->get();
+    auto _itr     = std::find_if(_results.begin(), _results.end(), [](const auto& _v) {
+        return _v.prefix().find(details::get_test_name()) != std::string::npos;
+    });
+    ASSERT_NE(_itr, _results.end());
+    EXPECT_EQ(_itr->data().get_laps(), 1000);
+    EXPECT_EQ(_itr->stats().get_count(), 1000);
+    for(double _q : { 0.5, 0.99, 0.999 })
+    {
+        EXPECT_LE(details::get_error(_itr->stats().get_quantile(_q),
+                                     details::get_quantile(_data, _q)),
+                  quantile_t::relative_accuracy)
+            << "quantile: " << _q;
+    }
+
+    // the sketch round-trips through the JSON serialization
+    std::stringstream _ss{};
+    {
+        tim::cereal::JSONOutputArchive _oa{ _ss };
+        _oa(tim::cereal::make_nvp("stats", _itr->stats()));
+    }
+    EXPECT_NE(_ss.str().find("\"p99\""), std::string::npos) << _ss.str();
+
+    quantile_t _stats{};
+    {
+        tim::cereal::JSONInputArchive _ia{ _ss };
+        _ia(tim::cereal::make_nvp("stats", _stats));
+    }
+    EXPECT_EQ(_stats.get_count(), 1000);
+    EXPECT_EQ(_stats.get_buckets(), _itr->stats().get_buckets());
+    EXPECT_DOUBLE_EQ(_stats.get_quantile(0.99), _itr->stats().get_quantile(0.99));
+
+    // merging the results adds the buckets
+    auto _other = _results;
+    tim::operation::finalize::merge<sample_value, true>(_results, _other);
+    _itr = std::find_if(_results.begin(), _results.end(), [](const auto& _v) {
+        return _v.prefix().find(details::get_test_name()) != std::string::npos;
+    });
+    ASSERT_NE(_itr, _results.end());
+    EXPECT_EQ(_itr->stats().get_count(), 2000);
+    EXPECT_EQ(_itr->stats().get_sketch_count(), 2000);
+    EXPECT_DOUBLE_EQ(_itr->stats().get_quantile(0.99), _stats.get_quantile(0.99));
+}
+
+//--------------------------------------------------------------------------------------//
@@ -0,0 +1,309 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file backends/procfs.hpp
+ * \headerfile backends/procfs.hpp "timemory/backends/procfs.hpp"
+ * Readers for the small files in /proc/<pid> (statm, io, net/dev) which keep the
+ * file descriptor open and re-read the content with a single pread(2) into a reusable
+ * buffer instead of opening a stream for every sample.
+ *
+ */
+
+#pragma once
+
+#include "timemory/backends/process.hpp"
+#include "timemory/macros/os.hpp"
+#include "timemory/mpl/type_traits.hpp"
+#include "timemory/mpl/types.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(TIMEMORY_LINUX)
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace tim
+{
+namespace procfs
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// the number of active \ref tim::procfs::scoped_coalesce instances on this thread and
+/// the generation of the outermost one
+struct coalesce_state
+{
+    int64_t  depth = 0;
+    uint64_t epoch = 1;
+};
+//
+inline coalesce_state&
+get_coalesce_state()
+{
+    static thread_local coalesce_state _instance{};
+    return _instance;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \struct tim::procfs::scoped_coalesce
+/// \brief While an instance exists on the thread, each \ref tim::procfs::reader reads
+/// its file at most once, e.g. page_rss and virtual_memory in the same bundle share
+/// a single read of /proc/<pid>/statm when the bundle is started or stopped.
+template <bool EnableV = true>
+struct scoped_coalesce
+{
+    scoped_coalesce()
+    {
+        auto& _state = get_coalesce_state();
+        if(_state.depth++ == 0)
+            ++_state.epoch;
+    }
+
+    ~scoped_coalesce() { --get_coalesce_state().depth; }
+
+    scoped_coalesce(const scoped_coalesce&) = delete;
+    scoped_coalesce(scoped_coalesce&&)      = delete;
+    scoped_coalesce& operator=(const scoped_coalesce&) = delete;
+    scoped_coalesce& operator=(scoped_coalesce&&) = delete;
+};
+//
+template <>
+struct scoped_coalesce<false>
+{};
+//
+/// true if any of the types samples from a file (\ref tim::trait::file_sampler)
+template <typename... Tp>
+struct uses_file_sampler
+: std::integral_constant<bool, (false || ... ||
+                                trait::file_sampler<
+                                    std::remove_pointer_t<decay_t<Tp>>>::value)>
+{};
+//
+template <typename... Tp>
+struct uses_file_sampler<type_list<Tp...>> : uses_file_sampler<Tp...>
+{};
+//
+template <typename Tp>
+using coalesce_t = scoped_coalesce<uses_file_sampler<Tp>::value>;
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \class tim::procfs::reader
+/// \brief Keeps a file open and reads the entire content with one pread(2) from offset
+/// zero into a buffer which is only ever grown. When constructed with a relative name,
+/// the file is /proc/<pid>/<name> of \ref tim::process::get_target_id and the file is
+/// re-opened if the target changes. Instances are not thread-safe: use one per thread.
+class reader
+{
+public:
+    explicit reader(std::string _name)
+    : m_name{ std::move(_name) }
+    {}
+
+    ~reader() { close(); }
+
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    reader(reader&& rhs) noexcept
+    : m_fd{ rhs.m_fd }
+    , m_pid{ rhs.m_pid }
+    , m_epoch{ rhs.m_epoch }
+    , m_name{ std::move(rhs.m_name) }
+    , m_buffer{ std::move(rhs.m_buffer) }
+    {
+        rhs.m_fd = -1;
+    }
+
+    reader& operator=(reader&&) = delete;
+
+    /// returns the null-terminated content of the file or nullptr if it is unreadable
+    const char* read()
+    {
+#if defined(TIMEMORY_LINUX)
+        auto& _state = get_coalesce_state();
+        auto  _pid   = (m_name.front() == '/') ? 0 : process::get_target_id();
+        if(m_fd >= 0 && _pid == m_pid && _state.depth > 0 && m_epoch == _state.epoch)
+            return m_buffer.data();
+
+        if(m_fd < 0 || _pid != m_pid)
+            open(_pid);
+        if(m_fd < 0)
+            return nullptr;
+
+        if(m_buffer.empty())
+            m_buffer.resize(512);
+
+        while(true)
+        {
+            auto _n = ::pread(m_fd, m_buffer.data(), m_buffer.size() - 1, 0);
+            if(_n < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                close();
+                return nullptr;
+            }
+            // the content may have been truncated
+            if(static_cast<size_t>(_n) + 1 >= m_buffer.size())
+            {
+                m_buffer.resize(2 * m_buffer.size());
+                continue;
+            }
+            m_buffer[_n] = '\0';
+            break;
+        }
+        m_epoch = (_state.depth > 0) ? _state.epoch : 0;
+        return m_buffer.data();
+#else
+        return nullptr;
+#endif
+    }
+
+private:
+    void open(process::id_t _pid)
+    {
+#if defined(TIMEMORY_LINUX)
+        close();
+        m_pid = _pid;
+        if(m_name.front() == '/')
+        {
+            m_fd = ::open(m_name.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        else
+        {
+            char _path[64];
+            if(snprintf(_path, sizeof(_path), "/proc/%li/%s", (long int) _pid,
+                        m_name.c_str()) < static_cast<int>(sizeof(_path)))
+                m_fd = ::open(_path, O_RDONLY | O_CLOEXEC);
+        }
+#else
+        (void) _pid;
+#endif
+    }
+
+    void close()
+    {
+#if defined(TIMEMORY_LINUX)
+        if(m_fd >= 0)
+            ::close(m_fd);
+#endif
+        m_fd    = -1;
+        m_epoch = 0;
+    }
+
+private:
+    int               m_fd    = -1;
+    process::id_t     m_pid   = 0;
+    uint64_t          m_epoch = 0;
+    std::string       m_name  = {};
+    std::vector<char> m_buffer = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// parses the next non-negative integer after the position, skipping any characters
+/// which are not digits. Returns the position following the integer or nullptr if the
+/// end of the content was reached.
+inline const char*
+parse(const char* _p, int64_t& _v)
+{
+    if(!_p)
+        return nullptr;
+    while(*_p != '\0' && (*_p < '0' || *_p > '9'))
+        ++_p;
+    if(*_p == '\0')
+        return nullptr;
+    int64_t _val = 0;
+    while(*_p >= '0' && *_p <= '9')
+        _val = (10 * _val) + (*_p++ - '0');
+    _v = _val;
+    return _p;
+}
+//
+/// skips the rest of the current line
+inline const char*
+next_line(const char* _p)
+{
+    if(!_p)
+        return nullptr;
+    while(*_p != '\0' && *_p != '\n')
+        ++_p;
+    return (*_p == '\0') ? nullptr : _p + 1;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline reader&
+get_statm_reader()
+{
+    static thread_local reader _instance{ "statm" };
+    return _instance;
+}
+//
+inline reader&
+get_io_reader()
+{
+    static thread_local reader _instance{ "io" };
+    return _instance;
+}
+//
+inline reader&
+get_net_dev_reader()
+{
+    static thread_local reader _instance{ "net/dev" };
+    return _instance;
+}
+//
+/// reader for an absolute path, e.g. /sys/class/net/<iface>/statistics/rx_bytes
+inline reader&
+get_reader(const std::string& _path)
+{
+    static thread_local std::unordered_map<std::string, reader> _instance{};
+    auto itr = _instance.find(_path);
+    if(itr == _instance.end())
+        itr = _instance.emplace(_path, reader{ _path }).first;
+    return itr->second;
+}
+//
+/// reads the field (zero-based) of /proc/<pid>/statm in units of pages
+inline int64_t
+read_statm(size_t _field)
+{
+    int64_t _v = 0;
+    auto    _p = get_statm_reader().read();
+    for(size_t i = 0; i <= _field && _p; ++i)
+        _p = parse(_p, _v);
+    return (_p) ? _v : 0;
+}
+}  // namespace procfs
+}  // namespace tim
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "timemory/backends/process.hpp"
+#include "timemory/backends/procfs.hpp"
 #include "timemory/mpl/apply.hpp"
 #include "timemory/utility/macros.hpp"
 #include "timemory/utility/types.hpp"
@@ -89,8 +90,13 @@ struct io_cache
     template <size_t NumReads = 6, size_t N>
     static inline auto& read(std::array<int64_t, N>& _data)
     {
-        std::ifstream ifs(get_filename().c_str());
-        _data = read(ifs, _data, std::make_index_sequence<NumReads>{});
+        static_assert(NumReads <= N, "Error! Number of reads exceeds the array size");
+        auto _p = procfs::get_io_reader().read();
+        // each line is "<label>: <value>" and none of the labels contain digits
+        for(size_t i = 0; i < NumReads && _p; ++i)
+            _p = procfs::parse(_p, _data[i]);
+        if(!_p)
+            _data.fill(0);
         return _data;
     }
 
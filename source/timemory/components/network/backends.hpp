@@ -26,6 +26,7 @@
 #pragma once
 
 #include "timemory/backends/process.hpp"
+#include "timemory/backends/procfs.hpp"
 #include "timemory/macros/language.hpp"
 #include "timemory/macros/os.hpp"
 #include "timemory/settings/settings.hpp"
@@ -35,6 +36,7 @@
 #include "timemory/utility/types.hpp"
 #include "timemory/variadic/macros.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -132,7 +134,7 @@ public:
     {}
 
     explicit network_stats(const std::string& _iface)
-    : m_data{ read(get_filename(), _iface) }
+    : m_data{ read_net_dev(_iface) }
     {}
 #else
     template <size_t N>
@@ -313,9 +315,9 @@ private:
                             std::integral_constant<size_t, Idx>)
     {
         static_assert(Idx < N, "Error! index exceeds array size");
-        std::ifstream ifs{ _paths.at(Idx) };
-        if(ifs)
-            ifs >> _data[Idx];
+        int64_t _v = 0;
+        if(procfs::parse(procfs::get_reader(_paths.at(Idx)).read(), _v))
+            _data[Idx] = _v;
     }
 
     template <typename Tp, size_t N, size_t... Idx>
@@ -365,6 +367,37 @@ private:
         }
         return data_type{};
     }
+
+    /// reads the entry of the interface from /proc/<pid>/net/dev
+    static inline data_type read_net_dev(const std::string& _iface)
+    {
+        // each line is "<iface>: <16 values>" where the interface name may contain
+        // digits so the values are parsed after the colon
+        auto _p = procfs::get_net_dev_reader().read();
+        for(; _p; _p = procfs::next_line(_p))
+        {
+            const char* _colon = strchr(_p, ':');
+            const char* _eol   = strchr(_p, '\n');
+            if(!_colon || (_eol && _colon > _eol))
+                continue;
+            if(std::string{ _p, _colon }.find(_iface) == std::string::npos)
+                continue;
+            data_type _data{};
+            int64_t   _values[12] = {};
+            _p                    = _colon + 1;
+            for(auto& itr : _values)
+                _p = procfs::parse(_p, itr);
+            if(!_p)
+                return data_type{};
+            for(size_t i = 0; i < 4; ++i)
+            {
+                _data[i]     = _values[i];
+                _data[i + 4] = _values[i + 8];
+            }
+            return _data;
+        }
+        return data_type{};
+    }
 };
 }  // namespace cache
 }  // namespace tim
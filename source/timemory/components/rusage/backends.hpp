@@ -26,6 +26,7 @@
 #pragma once
 
 #include "timemory/backends/process.hpp"
+#include "timemory/backends/procfs.hpp"
 #include "timemory/macros/os.hpp"
 #include "timemory/units.hpp"
 #include "timemory/utility/macros.hpp"
@@ -398,21 +399,8 @@ tim::get_data_rss(rusage_type_t _rutype)
 #    else  // Linux
     (void) _rutype;
 
-    std::string fstatm = [&]() {
-        std::stringstream fio;
-        fio << "/proc/" << get_rusage_pid() << "/statm";
-        return fio.str();
-    }();
-    int64_t       drss_size = 0;
-    std::ifstream ifs;
-    ifs.open(fstatm.c_str());
-    if(ifs)
-    {
-        static int64_t dummy = 0;
-        ifs >> dummy >> dummy >> dummy >> dummy >> dummy >> drss_size;
-    }
-    ifs.close();
-    return static_cast<int64_t>(drss_size * units::get_page_size());
+    // sixth field of /proc/<pid>/statm
+    return static_cast<int64_t>(procfs::read_statm(5) * units::get_page_size());
 #    endif
 #else
     (void) _rutype;
@@ -643,20 +631,8 @@ tim::get_page_rss()
 
 #    else  // Linux
 
-    int64_t           rss = 0;
-    std::stringstream fio;
-    fio << "/proc/" << get_rusage_pid() << "/statm";
-    FILE* fp = fopen(fio.str().c_str(), "r");
-    if(fp && fscanf(fp, "%*s%ld", &rss) == 1)
-    {
-        fclose(fp);
-        return static_cast<int64_t>(rss * units::get_page_size());
-    }
-
-    if(fp)
-        fclose(fp);
-
-    return static_cast<int64_t>(0);
+    // second field of /proc/<pid>/statm
+    return static_cast<int64_t>(procfs::read_statm(1) * units::get_page_size());
 
 #    endif
 #elif defined(TIMEMORY_WINDOWS)
@@ -712,18 +688,8 @@ tim::get_virt_mem()
                         __LINE__, (long int) get_rusage_pid());
 #        endif
 
-    std::string fstatm = [&]() {
-        std::stringstream fio;
-        fio << "/proc/" << get_rusage_pid() << "/statm";
-        return fio.str();
-    }();
-    int64_t       vm_size = 0;
-    std::ifstream ifs;
-    ifs.open(fstatm.c_str());
-    if(ifs)
-        ifs >> vm_size;
-    ifs.close();
-    return static_cast<int64_t>(vm_size * units::get_page_size());
+    // first field of /proc/<pid>/statm
+    return static_cast<int64_t>(procfs::read_statm(0) * units::get_page_size());
 
 #    endif
 #elif defined(TIMEMORY_WINDOWS)
@@ -33,6 +33,7 @@
 #include "timemory/tpls/cereal/cereal.hpp"
 #include "timemory/utility/macros.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
@@ -40,11 +41,16 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 namespace tim
 {
 template <typename Tp>
 struct statistics;
+
+template <typename Tp>
+struct quantile_statistics;
 }
 
 namespace tim
@@ -61,6 +67,12 @@ struct StaticVersion<::tim::statistics<Tp>>
 {
     static constexpr uint32_t version = 0;
 };
+
+template <typename Tp>
+struct StaticVersion<::tim::quantile_statistics<Tp>>
+{
+    static constexpr uint32_t version = 0;
+};
 }  // namespace detail
 }  // namespace cereal
 namespace math
@@ -377,6 +389,303 @@ public:
     void load(Archive&, const unsigned int)
     {}
 };
+//
+/// \struct tim::quantile_statistics
+/// \tparam Tp arithmetic data type for statistical accumulation
+///
+/// \brief Extends \ref tim::statistics with a mergeable quantile sketch. The values are
+/// counted in logarithmically spaced buckets so that every quantile estimate is within
+/// \ref relative_accuracy of an exact value of the distribution. At most \ref
+/// max_buckets buckets are kept: when the range is exceeded, the lowest buckets are
+/// collapsed into one so that the upper quantiles (e.g. the tail latency) keep their
+/// accuracy. Values which are not positive are counted in a separate zero bucket. Two
+/// sketches are merged by adding the counts of the buckets. Enable with
+/// \ref tim::trait::record_quantiles.
+///
+template <typename Tp>
+struct quantile_statistics : public statistics<Tp>
+{
+    static_assert(std::is_arithmetic<Tp>::value,
+                  "quantile_statistics requires an arithmetic data type");
+
+public:
+    using value_type  = Tp;
+    using base_type   = statistics<Tp>;
+    using this_type   = quantile_statistics<Tp>;
+    using count_type  = uint64_t;
+    using bucket_type = std::vector<count_type>;
+
+    static constexpr double relative_accuracy = 0.01;
+    static constexpr size_t max_buckets       = 512;
+
+public:
+    quantile_statistics()                               = default;
+    ~quantile_statistics()                              = default;
+    quantile_statistics(const quantile_statistics&)     = default;
+    quantile_statistics(quantile_statistics&&) noexcept = default;
+    quantile_statistics& operator=(const quantile_statistics&) = default;
+    quantile_statistics& operator=(quantile_statistics&&) noexcept = default;
+
+    explicit quantile_statistics(const value_type& val)
+    : base_type{ val }
+    {
+        insert(val, 1);
+    }
+
+    quantile_statistics& operator=(const value_type& val)
+    {
+        reset();
+        return (*this += val);
+    }
+
+public:
+    /// estimate of the value at the given quantile, e.g. 0.99 for the 99th percentile
+    value_type get_quantile(double _q) const
+    {
+        count_type _total = get_sketch_count();
+        if(_total == 0)
+            return value_type{};
+
+        _q         = std::min<double>(std::max<double>(_q, 0.0), 1.0);
+        auto _rank = static_cast<count_type>(_q * (_total - 1));
+        if(_rank < m_zero)
+            return std::min<value_type>(this->get_min(), value_type{});
+
+        count_type _sum = m_zero;
+        for(size_t i = 0; i < m_buckets.size(); ++i)
+        {
+            _sum += m_buckets[i];
+            if(_sum > _rank)
+            {
+                // the midpoint of the bucket (in relative terms)
+                auto _idx = static_cast<double>(m_offset + static_cast<int64_t>(i));
+                auto _val = 2.0 * std::pow(gamma(), _idx) / (gamma() + 1.0) * m_scale;
+                return clamp(_val);
+            }
+        }
+        return this->get_max();
+    }
+
+    /// number of values in the sketch
+    count_type get_sketch_count() const
+    {
+        count_type _sum = m_zero;
+        for(const auto& itr : m_buckets)
+            _sum += itr;
+        return _sum;
+    }
+
+    const bucket_type& get_buckets() const { return m_buckets; }
+
+    void reset()
+    {
+        base_type::reset();
+        m_offset = 0;
+        m_zero   = 0;
+        m_scale  = 1.0;
+        m_buckets.clear();
+    }
+
+public:
+    // Operators (value_type)
+    quantile_statistics& operator+=(const value_type& val)
+    {
+        base_type::operator+=(val);
+        insert(static_cast<double>(val) / m_scale, 1);
+        return *this;
+    }
+
+    quantile_statistics& operator-=(const value_type& val)
+    {
+        base_type::operator-=(val);
+        return *this;
+    }
+
+    // the sketch is scaled lazily so that a unit conversion does not move the buckets
+    quantile_statistics& operator*=(const value_type& val)
+    {
+        base_type::operator*=(val);
+        m_scale *= static_cast<double>(val);
+        return *this;
+    }
+
+    quantile_statistics& operator/=(const value_type& val)
+    {
+        base_type::operator/=(val);
+        m_scale /= static_cast<double>(val);
+        return *this;
+    }
+
+public:
+    // Operators (this_type)
+    quantile_statistics& operator+=(const quantile_statistics& rhs)
+    {
+        base_type::operator+=(rhs);
+        merge(rhs);
+        return *this;
+    }
+
+    /// the sketch of a difference of distributions is unknown (e.g. the exclusive
+    /// values of a node in the call-graph) so the quantiles are discarded
+    quantile_statistics& operator-=(const quantile_statistics& rhs)
+    {
+        base_type::operator-=(rhs);
+        m_offset = 0;
+        m_zero   = 0;
+        m_scale  = 1.0;
+        m_buckets.clear();
+        return *this;
+    }
+
+private:
+    static double gamma()
+    {
+        return (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+    }
+
+    static double inv_log_gamma()
+    {
+        static const double _v = 1.0 / std::log(gamma());
+        return _v;
+    }
+
+    value_type clamp(double _val) const
+    {
+        _val = std::max<double>(_val, this->get_min());
+        _val = std::min<double>(_val, this->get_max());
+        return static_cast<value_type>(_val);
+    }
+
+    void insert(double _val, count_type _n)
+    {
+        if(!(_val > 0.0) || !std::isfinite(_val))
+        {
+            m_zero += _n;
+            return;
+        }
+        add(static_cast<int64_t>(std::ceil(std::log(_val) * inv_log_gamma())), _n);
+    }
+
+    void add(int64_t _idx, count_type _n)
+    {
+        if(m_buckets.empty())
+        {
+            m_offset = _idx;
+            m_buckets.assign(1, _n);
+            return;
+        }
+
+        constexpr auto _max = static_cast<int64_t>(max_buckets);
+        auto           _end = m_offset + static_cast<int64_t>(m_buckets.size());
+        if(_idx < m_offset)
+        {
+            // never grow past the bucket limit towards the lowest values
+            _idx = std::max<int64_t>(_idx, _end - _max);
+            m_buckets.insert(m_buckets.begin(), m_offset - _idx, 0);
+            m_offset = _idx;
+        }
+        else if(_idx >= _end)
+        {
+            m_buckets.resize(_idx - m_offset + 1, 0);
+        }
+        m_buckets[_idx - m_offset] += _n;
+
+        // collapse the lowest buckets
+        if(m_buckets.size() > max_buckets)
+        {
+            auto       _excess = m_buckets.size() - max_buckets;
+            count_type _sum    = 0;
+            for(size_t i = 0; i <= _excess; ++i)
+                _sum += m_buckets[i];
+            m_buckets.erase(m_buckets.begin(), m_buckets.begin() + _excess);
+            m_buckets.front() = _sum;
+            m_offset += _excess;
+        }
+    }
+
+    void merge(const quantile_statistics& rhs)
+    {
+        m_zero += rhs.m_zero;
+        if(rhs.m_buckets.empty())
+            return;
+
+        if(m_buckets.empty() || rhs.m_scale == m_scale)
+        {
+            if(m_buckets.empty())
+                m_scale = rhs.m_scale;
+            for(size_t i = 0; i < rhs.m_buckets.size(); ++i)
+            {
+                if(rhs.m_buckets[i] > 0)
+                    add(rhs.m_offset + static_cast<int64_t>(i), rhs.m_buckets[i]);
+            }
+        }
+        else
+        {
+            // re-insert the midpoint of each bucket in the current scale
+            for(size_t i = 0; i < rhs.m_buckets.size(); ++i)
+            {
+                if(rhs.m_buckets[i] == 0)
+                    continue;
+                auto _idx = static_cast<double>(rhs.m_offset + static_cast<int64_t>(i));
+                auto _val = 2.0 * std::pow(gamma(), _idx) / (gamma() + 1.0);
+                insert(_val * rhs.m_scale / m_scale, rhs.m_buckets[i]);
+            }
+        }
+    }
+
+private:
+    int64_t     m_offset  = 0;
+    count_type  m_zero    = 0;
+    double      m_scale   = 1.0;
+    bucket_type m_buckets = {};
+
+public:
+    // friend operator for output
+    friend std::ostream& operator<<(std::ostream& os, const quantile_statistics& obj)
+    {
+        os << static_cast<const base_type&>(obj) << " [p50: " << obj.get_quantile(0.5)
+           << "] [p99: " << obj.get_quantile(0.99)
+           << "] [p999: " << obj.get_quantile(0.999) << "]";
+        return os;
+    }
+
+    // friend operator for addition
+    friend quantile_statistics operator+(const quantile_statistics& lhs,
+                                         const quantile_statistics& rhs)
+    {
+        return quantile_statistics(lhs) += rhs;
+    }
+
+    friend quantile_statistics operator-(const quantile_statistics& lhs,
+                                         const quantile_statistics& rhs)
+    {
+        return quantile_statistics(lhs) -= rhs;
+    }
+
+    template <typename Archive>
+    void save(Archive& ar, const unsigned int version) const
+    {
+        base_type::save(ar, version);
+        ar(cereal::make_nvp("p50", get_quantile(0.5)),
+           cereal::make_nvp("p90", get_quantile(0.9)),
+           cereal::make_nvp("p99", get_quantile(0.99)),
+           cereal::make_nvp("p999", get_quantile(0.999)),
+           cereal::make_nvp("sketch_offset", m_offset),
+           cereal::make_nvp("sketch_zero", m_zero),
+           cereal::make_nvp("sketch_scale", m_scale),
+           cereal::make_nvp("sketch_buckets", m_buckets));
+    }
+
+    template <typename Archive>
+    void load(Archive& ar, const unsigned int version)
+    {
+        base_type::load(ar, version);
+        ar(cereal::make_nvp("sketch_offset", m_offset),
+           cereal::make_nvp("sketch_zero", m_zero),
+           cereal::make_nvp("sketch_scale", m_scale),
+           cereal::make_nvp("sketch_buckets", m_buckets));
+    }
+};
 
 }  // namespace tim
 
@@ -60,11 +60,7 @@ get_hash_ids()
         auto_lock_t          _lk{ type_mutex<hash_map_t>(), std::defer_lock };
         if(!_lk.owns_lock())
             _lk.lock();
-        for(const auto& itr : *_inst)
-        {
-            if(_main->find(itr.first) == _main->end())
-                _main->emplace(itr.first, itr.second);
-        }
+        _main->merge(*_inst);
     } };
     return _inst;
     (void) _dtor;
@@ -94,11 +90,7 @@ get_hash_aliases()
         auto_lock_t          _lk{ type_mutex<hash_alias_map_t>(), std::defer_lock };
         if(!_lk.owns_lock())
             _lk.lock();
-        for(const auto& itr : *_inst)
-        {
-            if(_main->find(itr.first) == _main->end())
-                _main->emplace(itr.first, itr.second);
-        }
+        _main->merge(*_inst);
     } };
     return _inst;
     (void) _dtor;
@@ -145,8 +137,8 @@ TIMEMORY_HASH_LINKAGE(hash_value_t)
 add_hash_id(hash_map_ptr_t& _hash_map, string_view_cref_t _prefix)
 {
     hash_value_t _hash_id = std::hash<std::string_view>{}(_prefix);
-    if(_hash_map && _hash_map->count(_hash_id) == 0)
-        _hash_map->emplace(_hash_id, std::string{ _prefix });
+    if(_hash_map)
+        _hash_map->emplace(_hash_id, _prefix);
     return _hash_id;
 }
 //
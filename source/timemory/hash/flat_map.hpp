@@ -0,0 +1,235 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace tim
+{
+inline namespace hash
+{
+/// hash values which are addresses (e.g. static_string) have zeroed low bits and
+/// std::hash<size_t> is an identity function on most platforms so the bits are mixed
+/// before they are masked into a power-of-two sized table
+inline size_t
+get_mixed_hash(size_t _key)
+{
+    constexpr uint64_t _mult = 0x9e3779b97f4a7c15ull;
+    auto               _v    = static_cast<uint64_t>(_key) * _mult;
+    return static_cast<size_t>(_v ^ (_v >> 32));
+}
+//
+//--------------------------------------------------------------------------------------//
+/// \class tim::hash::flat_map
+/// \tparam Tp Mapped type
+///
+/// \brief Open-addressed map keyed by a pre-computed hash value. The probe table only
+/// holds the keys and a 32-bit index so that lookups walk a contiguous array with
+/// linear probing. The entries (key + mapped value) are appended to a chunked arena
+/// (std::deque) which never relocates them: pointers and references to mapped values
+/// (e.g. the std::string* returned by \ref tim::get_hash_identifier) remain valid when
+/// the probe table grows and iteration follows insertion order. Entries are never
+/// erased individually. \ref merge inserts all the missing entries of another map in a
+/// single pass.
+template <typename Tp>
+class flat_map
+{
+public:
+    using key_type        = size_t;
+    using mapped_type     = Tp;
+    using value_type      = std::pair<const key_type, mapped_type>;
+    using size_type       = size_t;
+    using index_type      = uint32_t;
+    using arena_type      = std::deque<value_type>;
+    using iterator        = typename arena_type::iterator;
+    using const_iterator  = typename arena_type::const_iterator;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+private:
+    struct slot
+    {
+        key_type   key   = 0;
+        index_type index = npos;
+    };
+
+public:
+    flat_map()                    = default;
+    ~flat_map()                   = default;
+    flat_map(const flat_map&)     = default;
+    flat_map(flat_map&&)          = default;
+
+    flat_map& operator=(const flat_map&) = default;
+    flat_map& operator=(flat_map&&) = default;
+
+    iterator       begin() { return m_arena.begin(); }
+    iterator       end() { return m_arena.end(); }
+    const_iterator begin() const { return m_arena.begin(); }
+    const_iterator end() const { return m_arena.end(); }
+    const_iterator cbegin() const { return m_arena.cbegin(); }
+    const_iterator cend() const { return m_arena.cend(); }
+
+    size_type size() const { return m_arena.size(); }
+    bool      empty() const { return m_arena.empty(); }
+
+    iterator find(key_type _key)
+    {
+        auto _idx = lookup(_key);
+        return (_idx == npos) ? end() : begin() + _idx;
+    }
+
+    const_iterator find(key_type _key) const
+    {
+        auto _idx = lookup(_key);
+        return (_idx == npos) ? end() : begin() + _idx;
+    }
+
+    size_type count(key_type _key) const { return (lookup(_key) == npos) ? 0 : 1; }
+
+    mapped_type& at(key_type _key)
+    {
+        auto _idx = lookup(_key);
+        if(_idx == npos)
+            throw std::out_of_range("tim::hash::flat_map::at");
+        return m_arena[_idx].second;
+    }
+
+    const mapped_type& at(key_type _key) const
+    {
+        auto _idx = lookup(_key);
+        if(_idx == npos)
+            throw std::out_of_range("tim::hash::flat_map::at");
+        return m_arena[_idx].second;
+    }
+
+    mapped_type& operator[](key_type _key) { return emplace(_key).first->second; }
+
+    /// constructs the mapped value from the arguments if the key does not exist
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(key_type _key, Args&&... _args)
+    {
+        reserve(size() + 1);
+        auto _pos = probe(_key);
+        if(m_slots[_pos].index != npos)
+            return { begin() + m_slots[_pos].index, false };
+        auto _idx = static_cast<index_type>(m_arena.size());
+        m_arena.emplace_back(std::piecewise_construct, std::forward_as_tuple(_key),
+                             std::forward_as_tuple(std::forward<Args>(_args)...));
+        m_slots[_pos] = slot{ _key, _idx };
+        return { begin() + _idx, true };
+    }
+
+    template <typename Up>
+    std::pair<iterator, bool> insert(Up&& _v)
+    {
+        return emplace(_v.first, std::forward<Up>(_v).second);
+    }
+
+    /// inserts every entry of the other map which does not exist in this map. The
+    /// probe table is grown at most once.
+    void merge(const flat_map& _rhs)
+    {
+        if(&_rhs == this || _rhs.empty())
+            return;
+        reserve(size() + _rhs.size());
+        for(const auto& itr : _rhs.m_arena)
+        {
+            auto _pos = probe(itr.first);
+            if(m_slots[_pos].index != npos)
+                continue;
+            m_slots[_pos] = slot{ itr.first, static_cast<index_type>(m_arena.size()) };
+            m_arena.emplace_back(itr);
+        }
+    }
+
+    /// ensures that the given number of entries can exist without growing the table
+    void reserve(size_type _n)
+    {
+        // maximum load factor of 0.5
+        if(2 * _n <= m_slots.size())
+            return;
+        size_type _cap = (m_slots.empty()) ? 16 : m_slots.size();
+        while(2 * _n > _cap)
+            _cap *= 2;
+        rehash(_cap);
+    }
+
+    void clear()
+    {
+        m_arena.clear();
+        m_slots.clear();
+    }
+
+private:
+    static size_type mix(key_type _key) { return get_mixed_hash(_key); }
+
+    index_type lookup(key_type _key) const
+    {
+        if(m_slots.empty())
+            return npos;
+        size_type _mask = m_slots.size() - 1;
+        for(size_type i = mix(_key) & _mask;; i = (i + 1) & _mask)
+        {
+            const auto& _slot = m_slots[i];
+            if(_slot.index == npos || _slot.key == _key)
+                return _slot.index;
+        }
+    }
+
+    // returns the position of the key or the first empty slot in its probe sequence
+    size_type probe(key_type _key) const
+    {
+        size_type _mask = m_slots.size() - 1;
+        for(size_type i = mix(_key) & _mask;; i = (i + 1) & _mask)
+        {
+            const auto& _slot = m_slots[i];
+            if(_slot.index == npos || _slot.key == _key)
+                return i;
+        }
+    }
+
+    void rehash(size_type _n)
+    {
+        m_slots.assign(_n, slot{});
+        for(size_type i = 0; i < m_arena.size(); ++i)
+            m_slots[probe(m_arena[i].first)] =
+                slot{ m_arena[i].first, static_cast<index_type>(i) };
+    }
+
+private:
+    arena_type        m_arena = {};
+    std::vector<slot> m_slots = {};
+};
+}  // namespace hash
+}  // namespace tim
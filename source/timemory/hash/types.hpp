@@ -25,6 +25,7 @@
 #pragma once
 
 #include "timemory/api.hpp"
+#include "timemory/hash/flat_map.hpp"
 #include "timemory/hash/macros.hpp"
 #include "timemory/hash/static_string.hpp"
 #include "timemory/macros/attributes.hpp"
@@ -88,8 +89,8 @@ get_shared_ptr_lone_instance() TIMEMORY_VISIBLE;
 inline namespace hash
 {
 using hash_value_t        = size_t;
-using hash_map_t          = std::unordered_map<hash_value_t, std::string>;
-using hash_alias_map_t    = std::unordered_map<hash_value_t, hash_value_t>;
+using hash_map_t          = flat_map<std::string>;
+using hash_alias_map_t    = flat_map<hash_value_t>;
 using hash_map_ptr_t      = std::shared_ptr<hash_map_t>;
 using hash_map_ptr_pair_t = std::pair<hash_map_ptr_t, hash_map_ptr_t>;
 using hash_alias_ptr_t    = std::shared_ptr<hash_alias_map_t>;
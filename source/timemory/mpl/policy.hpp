@@ -39,6 +39,9 @@ namespace tim
 template <typename Tp>
 struct statistics;
 //
+template <typename Tp>
+struct quantile_statistics;
+//
 namespace policy
 {
 //======================================================================================//
@@ -49,9 +52,11 @@ struct record_statistics
     using type            = Tp;
     using this_type       = record_statistics<CompT, type>;
     using policy_type     = this_type;
-    using statistics_type = statistics<type>;
+    using statistics_type = conditional_t<
+        trait::record_quantiles<CompT>::value && std::is_arithmetic<type>::value,
+        quantile_statistics<type>, statistics<type>>;
 
-    void operator()(statistics<type>&, const CompT&, bool _accum = true);
+    void operator()(statistics_type&, const CompT&, bool _accum = true);
     void operator()(type&, const CompT&) {}
 };
 
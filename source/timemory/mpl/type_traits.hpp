@@ -521,6 +521,16 @@ struct statistics
     using type = std::tuple<>;
 };
 
+//--------------------------------------------------------------------------------------//
+/// \struct tim::trait::record_quantiles
+/// \brief trait that signifies the statistics of the component also record a mergeable
+/// quantile sketch (\ref tim::quantile_statistics) for estimating percentiles such as
+/// p50/p99/p999. Requires an arithmetic \ref tim::trait::statistics type.
+///
+template <typename T>
+struct record_quantiles : false_type
+{};
+
 //--------------------------------------------------------------------------------------//
 /// \struct tim::trait::permissive_statistics
 /// \brief trait that will suppress compilation error in
@@ -1093,6 +1103,17 @@ template <typename T>
 struct timeline_storage : false_type
 {};
 
+//--------------------------------------------------------------------------------------//
+/// \struct tim::trait::dense_call_graph
+/// \brief trait that configures type to locate hierarchical call-graph entries through
+/// a dense, per-thread child index (\ref tim::call_graph_index) instead of the
+/// (depth, hash) keyed maps. Re-entering an existing call-path becomes a lookup in the
+/// parent node's child table.
+///
+template <typename T>
+struct dense_call_graph : false_type
+{};
+
 //--------------------------------------------------------------------------------------//
 //
 //      determines if storage should be implemented
@@ -254,6 +254,9 @@ struct statistics;
 template <typename T>
 struct permissive_statistics;
 
+template <typename T>
+struct record_quantiles;
+
 template <typename T>
 struct sampler;
 
@@ -353,6 +356,9 @@ struct flat_storage;
 template <typename T>
 struct timeline_storage;
 
+template <typename T>
+struct dense_call_graph;
+
 template <typename T, typename V = trait::data<T>, typename A = trait::uses_storage<T>>
 struct uses_value_storage;
 
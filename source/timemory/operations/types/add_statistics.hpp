@@ -51,7 +51,7 @@ namespace policy
 //
 template <typename CompT, typename Tp>
 inline void
-record_statistics<CompT, Tp>::operator()(statistics<Tp>& _stats, const CompT& _obj,
+record_statistics<CompT, Tp>::operator()(statistics_type& _stats, const CompT& _obj,
                                          bool _last)
 {
     using component_type = std::remove_pointer_t<decay_t<CompT>>;
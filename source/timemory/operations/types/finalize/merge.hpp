@@ -108,12 +108,7 @@ merge<Type, true>::merge(storage_type& lhs, storage_type& rhs)
                 Type::get_label().c_str(), (unsigned long) rhs.get_hash_ids()->size(),
                 (unsigned long) get_main_hash_ids()->size());
 
-            auto _hash_ids = *rhs.get_hash_ids();
-            for(const auto& itr : _hash_ids)
-            {
-                if(get_main_hash_ids()->find(itr.first) == get_main_hash_ids()->end())
-                    get_main_hash_ids()->emplace(itr.first, itr.second);
-            }
+            get_main_hash_ids()->merge(*rhs.get_hash_ids());
         }
         // copy over aliases
         if(rhs.get_hash_aliases() && get_main_hash_aliases())
@@ -129,13 +124,7 @@ merge<Type, true>::merge(storage_type& lhs, storage_type& rhs)
                 Type::get_label().c_str(), (unsigned long) rhs.get_hash_aliases()->size(),
                 (unsigned long) get_main_hash_aliases()->size());
 
-            auto _hash_aliases = *rhs.get_hash_aliases();
-            for(const auto& itr : _hash_aliases)
-            {
-                if(get_main_hash_aliases()->find(itr.first) ==
-                   get_main_hash_aliases()->end())
-                    get_main_hash_aliases()->emplace(itr.first, itr.second);
-            }
+            get_main_hash_aliases()->merge(*rhs.get_hash_aliases());
         }
     };
 
@@ -312,6 +301,8 @@ merge<Type, true>::merge(storage_type& lhs, storage_type& rhs)
 
     lhs.graph().steal_resources(rhs.graph());
     rhs.data().clear();
+    // the nodes referenced by the dense index are now owned by lhs or freed
+    rhs.m_dense_index.clear();
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -634,10 +625,7 @@ merge<Type, false>::merge(storage_type&, storage_type& rhs)
         if(!_lk.owns_lock())
             _lk.lock();
 
-        for(const auto& itr : *rhs.get_hash_ids())
-        {
-            get_main_hash_ids()->emplace(itr.first, itr.second);
-        }
+        get_main_hash_ids()->merge(*rhs.get_hash_ids());
     }
 
     if(get_main_hash_aliases() && rhs.get_hash_aliases())
@@ -646,10 +634,7 @@ merge<Type, false>::merge(storage_type&, storage_type& rhs)
         if(!_lk.owns_lock())
             _lk.lock();
 
-        for(const auto& itr : *rhs.get_hash_aliases())
-        {
-            get_main_hash_aliases()->emplace(itr.first, itr.second);
-        }
+        get_main_hash_aliases()->merge(*rhs.get_hash_aliases());
     }
 }
 //
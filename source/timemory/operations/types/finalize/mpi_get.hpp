@@ -41,6 +41,8 @@
 #include "timemory/tpls/cereal/cereal/details/helpers.hpp"
 #include "timemory/utility/demangle.hpp"
 
+#include <cstring>
+#include <string>
 #include <type_traits>
 
 namespace tim
@@ -89,6 +91,20 @@ struct value_type
     static constexpr bool value = has_member_value_type<Tp>::value;
     using type                  = typename value_type_impl<Tp, value>::type;
 };
+
+/// true if the component does not provide its own load function, i.e. the only
+/// serialized fields are the laps and the value/accum/last data
+template <typename Tp, typename = void>
+struct has_default_load : std::false_type
+{};
+
+template <typename Tp>
+struct has_default_load<
+    Tp, std::enable_if_t<std::is_same<
+            decltype(&Tp::template load<cereal::JSONInputArchive>),
+            void (Tp::base_type::*)(cereal::JSONInputArchive&, unsigned int)>::value>>
+: std::true_type
+{};
 }  // namespace concepts
 //
 namespace operation
@@ -114,6 +130,14 @@ struct mpi_get<Type, true>
     using metadata_t             = typename get_type::metadata;
     using basic_tree_type        = typename get_type::basic_tree_vector_type;
     using basic_tree_vector_type = std::vector<basic_tree_type>;
+    using stats_type             = typename result_node::stats_type;
+    using value_type             = typename concepts::value_type<Type>::type;
+
+    /// results are exchanged in a flat binary layout when the component only
+    /// serializes its laps and data and the data and statistics are trivially copyable
+    static constexpr bool flat_layout = concepts::has_default_load<Type>::value &&
+                                        std::is_trivially_copyable<value_type>::value &&
+                                        std::is_trivially_copyable<stats_type>::value;
 
     static auto& plus(Type& lhs, const Type& rhs) { return (lhs += rhs); }
 
@@ -228,20 +252,95 @@ mpi_get<Type, true>::operator()(distrib_type& results)
     //  Used to convert a result to a serialization
     //
     auto send_serialize = [&](const result_type& src) {
-        std::stringstream ss;
+        if constexpr(flat_layout)
         {
-            auto oa = policy::output_archive<cereal::MinimalJSONOutputArchive,
-                                             TIMEMORY_API>::get(ss);
-            (*oa)(cereal::make_nvp("data", src));
+            // count, then per record: depth, hash, rolling hash, prefix length +
+            // characters, laps, value, accum, last, stats
+            std::string _buf{};
+            auto        _write = [&_buf](const auto& _v) {
+                _buf.append(reinterpret_cast<const char*>(&_v), sizeof(_v));
+            };
+            _write(static_cast<uint64_t>(src.size()));
+            for(const auto& itr : src)
+            {
+                _write(itr.depth());
+                _write(itr.hash());
+                _write(itr.rolling_hash());
+                _write(static_cast<uint64_t>(itr.prefix().length()));
+                _buf.append(itr.prefix());
+                _write(static_cast<int64_t>(itr.data().get_laps()));
+                _write(static_cast<value_type>(itr.data().get_value()));
+                _write(static_cast<value_type>(itr.data().get_accum()));
+                _write(static_cast<value_type>(itr.data().get_last()));
+                _write(itr.stats());
+            }
+            return _buf;
+        }
+        else
+        {
+            std::stringstream ss;
+            {
+                auto oa = policy::output_archive<cereal::MinimalJSONOutputArchive,
+                                                 TIMEMORY_API>::get(ss);
+                (*oa)(cereal::make_nvp("data", src));
+            }
+            return ss.str();
         }
-        return ss.str();
     };
 
     //------------------------------------------------------------------------------//
     //  Used to convert the serialization to a result
     //
     auto recv_serialize = [&](const std::string& src) {
-        result_type       ret;
+        result_type ret;
+        if constexpr(flat_layout)
+        {
+            size_t _pos  = 0;
+            auto   _read = [&src, &_pos](auto& _v) {
+                if(_pos + sizeof(_v) > src.length())
+                    return false;
+                std::memcpy(&_v, src.data() + _pos, sizeof(_v));
+                _pos += sizeof(_v);
+                return true;
+            };
+            uint64_t _n = 0;
+            _read(_n);
+            ret.reserve(_n);
+            for(uint64_t i = 0; i < _n; ++i)
+            {
+                result_node _obj{};
+                uint64_t    _len  = 0;
+                int64_t     _laps = 0;
+                value_type  _value{};
+                value_type  _accum{};
+                value_type  _last{};
+                if(!_read(_obj.depth()) || !_read(_obj.hash()) ||
+                   !_read(_obj.rolling_hash()) || !_read(_len) ||
+                   _pos + _len > src.length())
+                    break;
+                _obj.prefix().assign(src.data() + _pos, _len);
+                _pos += _len;
+                if(!_read(_laps) || !_read(_value) || !_read(_accum) ||
+                   !_read(_last) || !_read(_obj.stats()))
+                    break;
+                _obj.data().set_laps(_laps);
+                _obj.data().set_value(_value);
+                _obj.data().set_accum(_accum);
+                _obj.data().set_last(_last);
+                _obj.data().set_is_transient(true);
+                ret.emplace_back(std::move(_obj));
+            }
+            if(ret.size() != _n)
+            {
+                TIMEMORY_PRINT_HERE("Warning! Truncated data in "
+                                    "operation::finalize::mpi_get<%s>::recv_serialize: "
+                                    "%llu of %llu records",
+                                    demangle<Type>().c_str(),
+                                    (unsigned long long) ret.size(),
+                                    (unsigned long long) _n);
+            }
+            return ret;
+        }
         std::stringstream ss;
         ss << src;
         {
@@ -284,10 +383,67 @@ mpi_get<Type, true>::operator()(distrib_type& results)
 
     results = distrib_type(comm_size);
 
-    auto ret     = data.get();
-    auto str_ret = send_serialize(ret);
+    auto ret = data.get();
 
-    if(comm_rank == 0)
+    if(m_collapse && m_node_count <= 1)
+    {
+        //
+        //  Binomial tree reduction: in round k, the ranks with bit k set send their
+        //  partially merged data to (rank - 2^k) and drop out, the remaining ranks
+        //  receive from (rank + 2^k) and merge it into their own by hash. The root
+        //  rank holds the collapsed data after ceil(log2(comm_size)) rounds and
+        //  never holds more than two result arrays
+        //
+        if(m_debug || m_verbose > 3)
+        {
+            TIMEMORY_PRINT_HERE(
+                "[%s][pid=%i][rank=%i] collapsing %i records from %i ranks",
+                demangle<mpi_get<Type, true>>().c_str(), (int) process::get_id(),
+                comm_rank, (int) ret.size(), comm_size);
+        }
+
+        // the non-root ranks only report their own data
+        auto _collapsed = (comm_rank == 0) ? std::move(ret) : ret;
+        for(int _mask = 1; _mask < comm_size; _mask <<= 1)
+        {
+            if((comm_rank & _mask) != 0)
+            {
+                if(m_debug && m_verbose >= 3)
+                    TIMEMORY_PRINTF(stderr, "[SEND: %i] starting %i\n", comm_rank,
+                                    comm_rank - _mask);
+                mpi::send(send_serialize(_collapsed), comm_rank - _mask, 0, m_comm);
+                if(m_debug && m_verbose >= 3)
+                    TIMEMORY_PRINTF(stderr, "[SEND: %i] completed %i\n", comm_rank,
+                                    comm_rank - _mask);
+                break;
+            }
+            else if(comm_rank + _mask < comm_size)
+            {
+                std::string str;
+                if(m_debug && m_verbose >= 3)
+                    TIMEMORY_PRINTF(stderr, "[RECV: %i] starting %i\n", comm_rank,
+                                    comm_rank + _mask);
+                mpi::recv(str, comm_rank + _mask, 0, m_comm);
+                if(m_debug && m_verbose >= 3)
+                    TIMEMORY_PRINTF(stderr, "[RECV: %i] completed %i\n", comm_rank,
+                                    comm_rank + _mask);
+                auto _src = recv_serialize(str);
+                operation::finalize::merge<Type, true>(_collapsed, _src);
+            }
+        }
+
+        results = distrib_type{};
+        results.emplace_back((comm_rank == 0) ? std::move(_collapsed) : std::move(ret));
+
+        if(comm_rank == 0 && (m_debug || m_verbose > 3))
+        {
+            TIMEMORY_PRINT_HERE(
+                "[%s][pid=%i][rank=%i] collapsed into %i records from %i ranks",
+                demangle<mpi_get<Type, true>>().c_str(), (int) process::get_id(),
+                comm_rank, get_num_records(results), comm_size);
+        }
+    }
+    else if(comm_rank == 0)
     {
         //
         //  The root rank receives data from all non-root ranks and reports all data
@@ -311,56 +467,15 @@ mpi_get<Type, true>::operator()(distrib_type& results)
         //
         if(m_debug && m_verbose >= 3)
             TIMEMORY_PRINTF(stderr, "[SEND: %i] starting\n", comm_rank);
-        mpi::send(str_ret, 0, 0, m_comm);
+        mpi::send(send_serialize(ret), 0, 0, m_comm);
         if(m_debug && m_verbose >= 3)
             TIMEMORY_PRINTF(stderr, "[SEND: %i] completed\n", comm_rank);
         results = distrib_type{};
         results.emplace_back(std::move(ret));
     }
 
-    // collapse into a single result
-    if(comm_rank == 0 && m_collapse && m_node_count <= 1)
-    {
-        auto init_size = get_num_records(results);
-        if(m_debug || m_verbose > 3)
-        {
-            TIMEMORY_PRINT_HERE(
-                "[%s][pid=%i][rank=%i] collapsing %i records from %i ranks",
-                demangle<mpi_get<Type, true>>().c_str(), (int) process::get_id(),
-                comm_rank, init_size, comm_size);
-        }
-
-        auto _collapsed = distrib_type{};
-        // so we can pop off back
-        std::reverse(results.begin(), results.end());
-        while(!results.empty())
-        {
-            if(_collapsed.empty())
-            {
-                _collapsed.emplace_back(std::move(results.back()));
-            }
-            else
-            {
-                operation::finalize::merge<Type, true>(_collapsed.front(),
-                                                       results.back());
-            }
-            results.pop_back();
-        }
-
-        // assign results to collapsed entry
-        results = std::move(_collapsed);
-
-        if(m_debug || m_verbose > 3)
-        {
-            auto fini_size = get_num_records(results);
-            TIMEMORY_PRINT_HERE(
-                "[%s][pid=%i][rank=%i] collapsed %i records into %i records "
-                "from %i ranks",
-                demangle<mpi_get<Type, true>>().c_str(), (int) process::get_id(),
-                comm_rank, init_size, fini_size, comm_size);
-        }
-    }
-    else if(comm_rank == 0 && m_collapse && m_node_count > 1)
+    // collapse into bins
+    if(comm_rank == 0 && m_collapse && m_node_count > 1)
     {
         // calculate some size parameters
         int32_t nmod  = comm_size % m_node_count;
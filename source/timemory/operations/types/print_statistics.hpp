@@ -86,6 +86,7 @@ public:
             utility::write_entry(_os, "VAR", _stats.get_variance());
         if(trait::report<type>::stddev())
             utility::write_entry(_os, "STDDEV", _stats.get_stddev());
+        write_quantiles(_os, _stats, 0);
     }
 
     template <typename Self, typename Vp, typename Up = Tp,
@@ -102,7 +103,7 @@ public:
     template <template <typename> class Sp, typename Vp, typename Up = Tp,
               enable_if_t<stats_enabled<Up, Vp>::value, int> = 0>
     static TIMEMORY_NOINLINE TIMEMORY_COLD void get_header(utility::stream& _os,
-                                                           const Sp<Vp>&)
+                                                           const Sp<Vp>&    _stats)
     {
         if(!trait::report_statistics<type>::value || !trait::report<type>::stats())
             return;
@@ -119,6 +120,7 @@ public:
             utility::write_header(_os, "VAR", _flags, _width, _prec);
         if(trait::report<type>::stddev())
             utility::write_header(_os, "STDDEV", _flags, _width, _prec);
+        write_quantiles_header(_os, _stats, 0);
     }
 
     template <typename Vp, typename Up = Tp,
@@ -127,6 +129,38 @@ public:
     {}
 
     static void get_header(utility::stream&, const statistics<std::tuple<>>&) {}
+
+private:
+    // percentiles are reported when the statistics record a quantile sketch
+    template <typename StatsT>
+    static auto write_quantiles(utility::stream& _os, const StatsT& _stats, int)
+        -> decltype(_stats.get_quantile(0.5), void())
+    {
+        utility::write_entry(_os, "P50", _stats.get_quantile(0.5));
+        utility::write_entry(_os, "P99", _stats.get_quantile(0.99));
+        utility::write_entry(_os, "P999", _stats.get_quantile(0.999));
+    }
+
+    template <typename StatsT>
+    static void write_quantiles(utility::stream&, const StatsT&, long)
+    {}
+
+    template <typename StatsT>
+    static auto write_quantiles_header(utility::stream& _os, const StatsT& _stats, int)
+        -> decltype(_stats.get_quantile(0.5), void())
+    {
+        auto _flags = Tp::get_format_flags();
+        auto _width = Tp::get_width();
+        auto _prec  = Tp::get_precision();
+
+        utility::write_header(_os, "P50", _flags, _width, _prec);
+        utility::write_header(_os, "P99", _flags, _width, _prec);
+        utility::write_header(_os, "P999", _flags, _width, _prec);
+    }
+
+    template <typename StatsT>
+    static void write_quantiles_header(utility::stream&, const StatsT&, long)
+    {}
 };
 //
 //--------------------------------------------------------------------------------------//
@@ -1592,6 +1592,13 @@ settings::initialize_miscellaneous()
         10000, TIMEMORY_ESC(strset_t{ "native", "component", "data", "throttle" }),
         strvector_t({ "--" TIMEMORY_PROJECT_NAME "-throttle-value" }), 1);
 
+    TIMEMORY_SETTINGS_MEMBER_ARG_IMPL(
+        size_t, throttle_max_stride, TIMEMORY_SETTINGS_KEY("THROTTLE_MAX_STRIDE"),
+        "Throttled keys are only timed once every N calls and N doubles each time "
+        "throttle_count timed calls stay below throttle_value. This is the maximum N",
+        1024, TIMEMORY_ESC(strset_t{ "native", "component", "data", "throttle" }),
+        strvector_t({ "--" TIMEMORY_PROJECT_NAME "-throttle-max-stride" }), 1);
+
     TIMEMORY_SETTINGS_MEMBER_ARG_IMPL(
         bool, enable_signal_handler, TIMEMORY_SETTINGS_KEY("ENABLE_SIGNAL_HANDLER"),
         "Enable signals in timemory_init", false,
@@ -2480,6 +2487,8 @@ TIMEMORY_SETTINGS_MEMBER_DEF(size_t, throttle_count,
                              TIMEMORY_SETTINGS_KEY("THROTTLE_COUNT"))
 TIMEMORY_SETTINGS_MEMBER_DEF(size_t, throttle_value,
                              TIMEMORY_SETTINGS_KEY("THROTTLE_VALUE"))
+TIMEMORY_SETTINGS_MEMBER_DEF(size_t, throttle_max_stride,
+                             TIMEMORY_SETTINGS_KEY("THROTTLE_MAX_STRIDE"))
 TIMEMORY_SETTINGS_MEMBER_DEF(std::string, global_components,
                              TIMEMORY_SETTINGS_KEY("GLOBAL_COMPONENTS"))
 TIMEMORY_SETTINGS_MEMBER_DEF(std::string, tuple_components,
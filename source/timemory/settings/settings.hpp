@@ -313,6 +313,7 @@ struct TIMEMORY_VISIBILITY("default") settings
     TIMEMORY_SETTINGS_MEMBER_DECL(bool, add_secondary)
     TIMEMORY_SETTINGS_MEMBER_DECL(size_t, throttle_count)
     TIMEMORY_SETTINGS_MEMBER_DECL(size_t, throttle_value)
+    TIMEMORY_SETTINGS_MEMBER_DECL(size_t, throttle_max_stride)
     TIMEMORY_SETTINGS_MEMBER_DECL(std::string, global_components)
     TIMEMORY_SETTINGS_MEMBER_DECL(std::string, tuple_components)
     TIMEMORY_SETTINGS_MEMBER_DECL(std::string, list_components)
@@ -0,0 +1,243 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "timemory/hash/types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace tim
+{
+//--------------------------------------------------------------------------------------//
+/// \class tim::call_graph_index
+/// \tparam IterT Graph iterator type
+/// \tparam InlineN Number of children stored inline before spilling to the
+/// open-addressed table
+///
+/// \brief Dense, per-thread index of a call-graph used by \ref tim::storage when
+/// \ref tim::trait::dense_call_graph is enabled for a component. Every graph node
+/// visited through the index is assigned a small integer id and owns a child table
+/// keyed by the insertion hash. Re-entering an existing call-path is a lookup into
+/// the parent's child table (the key is already a hash so no further hashing is
+/// performed) followed by a pointer chase to the child entry. The node-pointer map
+/// is only consulted when the graph's current node was changed outside of the index
+/// (e.g. thread synchronization dummies or non-hierarchical inserts).
+template <typename IterT, size_t InlineN = 4>
+class call_graph_index
+{
+public:
+    using iterator   = IterT;
+    using index_type = uint32_t;
+    using key_type   = hash_value_t;
+
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+    struct child_entry
+    {
+        key_type   key   = 0;
+        index_type index = npos;
+    };
+
+    /// small inline child table which spills into an open-addressed table with
+    /// linear probing once more than InlineN children exist. The keys are mixed with
+    /// \ref tim::hash::get_mixed_hash before masking since they may be addresses
+    /// (e.g. static_string)
+    class child_table
+    {
+    public:
+        index_type find(key_type _key) const
+        {
+            if(m_table.empty())
+            {
+                for(uint32_t i = 0; i < m_size; ++i)
+                {
+                    if(m_inline[i].key == _key)
+                        return m_inline[i].index;
+                }
+                return npos;
+            }
+
+            size_t _mask = m_table.size() - 1;
+            for(size_t i = get_mixed_hash(_key) & _mask;; i = (i + 1) & _mask)
+            {
+                const auto& _entry = m_table[i];
+                if(_entry.index == npos)
+                    return npos;
+                if(_entry.key == _key)
+                    return _entry.index;
+            }
+        }
+
+        void insert(key_type _key, index_type _idx)
+        {
+            if(m_table.empty() && m_size < InlineN)
+            {
+                m_inline[m_size++] = child_entry{ _key, _idx };
+                return;
+            }
+
+            if(m_table.empty())
+            {
+                rehash(4 * InlineN);
+                for(uint32_t i = 0; i < m_size; ++i)
+                    emplace(m_inline[i]);
+            }
+            else if(4 * (m_size + 1) > 3 * m_table.size())
+            {
+                rehash(2 * m_table.size());
+            }
+
+            emplace(child_entry{ _key, _idx });
+            ++m_size;
+        }
+
+        size_t size() const { return m_size; }
+
+    private:
+        void emplace(child_entry _v)
+        {
+            size_t _mask = m_table.size() - 1;
+            for(size_t i = get_mixed_hash(_v.key) & _mask;; i = (i + 1) & _mask)
+            {
+                if(m_table[i].index == npos)
+                {
+                    m_table[i] = _v;
+                    return;
+                }
+            }
+        }
+
+        void rehash(size_t _n)
+        {
+            std::vector<child_entry> _old{};
+            std::swap(_old, m_table);
+            m_table.resize(_n, child_entry{});
+            for(const auto& itr : _old)
+            {
+                if(itr.index != npos)
+                    emplace(itr);
+            }
+        }
+
+    private:
+        uint32_t                         m_size   = 0;
+        std::array<child_entry, InlineN> m_inline = {};
+        std::vector<child_entry>         m_table  = {};
+    };
+
+    struct entry
+    {
+        iterator    itr      = {};
+        index_type  parent   = npos;
+        child_table children = {};
+    };
+
+public:
+    call_graph_index()  = default;
+    ~call_graph_index() = default;
+
+    call_graph_index(const call_graph_index&)     = delete;
+    call_graph_index(call_graph_index&&) noexcept = default;
+
+    call_graph_index& operator=(const call_graph_index&) = delete;
+    call_graph_index& operator=(call_graph_index&&) noexcept = default;
+
+    /// make the index current match the graph's current node
+    void sync(iterator _current)
+    {
+        if(m_current != npos && m_entries[m_current].itr == _current)
+            return;
+        m_current = get_index(_current, npos);
+    }
+
+    /// find a child of the current node. If found, the child becomes the current node
+    /// and a pointer to its iterator is returned.
+    iterator* find(key_type _key)
+    {
+        if(m_current == npos)
+            return nullptr;
+        auto _idx = m_entries[m_current].children.find(_key);
+        if(_idx == npos)
+            return nullptr;
+        m_current = _idx;
+        return &m_entries[_idx].itr;
+    }
+
+    /// register a child of the current node which becomes the new current node
+    void insert(key_type _key, iterator _child)
+    {
+        if(m_current == npos)
+            return;
+        auto _parent = m_current;
+        auto _idx    = get_index(_child, _parent);
+        m_entries[_parent].children.insert(_key, _idx);
+        m_current = _idx;
+    }
+
+    /// move the current node to the parent node
+    void pop()
+    {
+        if(m_current != npos)
+            m_current = m_entries[m_current].parent;
+    }
+
+    void clear()
+    {
+        m_current = npos;
+        m_entries.clear();
+        m_lookup.clear();
+    }
+
+    size_t size() const { return m_entries.size(); }
+    bool   empty() const { return m_entries.empty(); }
+
+private:
+    index_type get_index(iterator _itr, index_type _parent)
+    {
+        auto litr = m_lookup.find(_itr.node);
+        if(litr != m_lookup.end())
+        {
+            auto& _entry = m_entries[litr->second];
+            if(_entry.parent == npos)
+                _entry.parent = _parent;
+            return litr->second;
+        }
+        auto _idx = static_cast<index_type>(m_entries.size());
+        m_entries.emplace_back(entry{ _itr, _parent, child_table{} });
+        m_lookup.emplace(_itr.node, _idx);
+        return _idx;
+    }
+
+private:
+    index_type                                m_current = npos;
+    std::vector<entry>                        m_entries = {};
+    std::unordered_map<const void*, uint32_t> m_lookup  = {};
+};
+}  // namespace tim
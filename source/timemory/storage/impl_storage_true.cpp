@@ -85,16 +85,8 @@ storage<Type, true>::storage()
         {
             hash_map_t       _hash_ids     = *_master->get_hash_ids();
             hash_alias_map_t _hash_aliases = *_master->get_hash_aliases();
-            for(const auto& itr : _hash_ids)
-            {
-                if(m_hash_ids->find(itr.first) == m_hash_ids->end())
-                    m_hash_ids->insert({ itr.first, itr.second });
-            }
-            for(const auto& itr : _hash_aliases)
-            {
-                if(m_hash_aliases->find(itr.first) == m_hash_aliases->end())
-                    m_hash_aliases->insert({ itr.first, itr.second });
-            }
+            m_hash_ids->merge(_hash_ids);
+            m_hash_aliases->merge(_hash_aliases);
         }
     }
 
@@ -128,16 +120,8 @@ storage<Type, true>::storage(standalone_storage, int64_t _instance_id, std::stri
     {
         hash_map_t       _hash_ids     = *_master->get_hash_ids();
         hash_alias_map_t _hash_aliases = *_master->get_hash_aliases();
-        for(const auto& itr : _hash_ids)
-        {
-            if(m_hash_ids->find(itr.first) == m_hash_ids->end())
-                m_hash_ids->insert({ itr.first, itr.second });
-        }
-        for(const auto& itr : _hash_aliases)
-        {
-            if(m_hash_aliases->find(itr.first) == m_hash_aliases->end())
-                m_hash_aliases->insert({ itr.first, itr.second });
-        }
+        m_hash_ids->merge(_hash_ids);
+        m_hash_aliases->merge(_hash_aliases);
     }
 
     m_printer = std::make_shared<printer_t>(m_label, this, m_settings);
@@ -173,6 +157,7 @@ storage<Type, true>::~storage()
         }
     }
 
+    m_dense_index.clear();
     delete m_graph_data_instance;
     m_graph_data_instance = nullptr;
 
@@ -393,6 +378,8 @@ template <typename Type>
 typename storage<Type, true>::iterator
 storage<Type, true>::pop()
 {
+    if constexpr(trait::dense_call_graph<Type>::value)
+        m_dense_index.pop();
     return _data().pop_graph();
 }
 //
@@ -933,6 +920,8 @@ storage<Type, true>::reset()
     // have the data graph erase all children of the head node
     if(m_graph_data_instance)
         m_graph_data_instance->reset();
+    // all the iterators in the dense index are invalidated
+    m_dense_index.clear();
     // erase all the cached iterators except for m_node_ids[0][0]
     for(auto& ditr : m_node_ids)
     {
@@ -984,6 +973,15 @@ storage<Type, true>::insert(scope::config scope_data, const Type& obj, uint64_t
     auto hash_value = scope_data.compute_hash<force_tree_t, force_flat_t, force_time_t>(
         hash_id, hash_depth, m_timeline_counter);
 
+    // when the dense index is enabled, re-entering an existing call-path is a lookup in
+    // the child table of the current node and the hash alias was added on first visit
+    if constexpr(trait::dense_call_graph<Type>::value && !force_flat_t::value &&
+                 !force_time_t::value)
+    {
+        if(!scope_data.is_flat() && !scope_data.is_timeline() && _tid == m_thread_idx)
+            return insert_dense(hash_id, hash_value, obj, hash_depth, _tid);
+    }
+
     // alias the true id with the insertion key
     add_hash_id(hash_id, hash_value);
 
@@ -1111,6 +1109,34 @@ storage<Type, true>::insert_tree(uint64_t hash_id, const Type& obj, uint64_t has
     return insert_hierarchy(hash_id, obj, hash_depth, has_head, _tid);
 }
 
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+typename storage<Type, true>::iterator
+storage<Type, true>::insert_dense(uint64_t hash_id, uint64_t hash_value, const Type& obj,
+                                  uint64_t hash_depth, int64_t _tid)
+{
+    auto& _graph_data = _data();
+    auto  _current    = _graph_data.current();
+
+    m_dense_index.sync(_current);
+    auto* _existing = m_dense_index.find(hash_value);
+    if(_existing)
+    {
+        _graph_data.depth() = (*_existing)->depth();
+        return (_graph_data.current() = *_existing);
+    }
+
+    // first visit: fall back to the hierarchical insert and cache the result if it
+    // is a child of the current node. Any other result (e.g. a sibling match) leaves
+    // the index out of sync with the graph and it will re-sync on the next insert
+    add_hash_id(hash_id, hash_value);
+    auto itr = insert_tree(hash_value, obj, hash_depth, _tid);
+    if(itr && graph_t::parent(itr) == _current)
+        m_dense_index.insert(hash_value, itr);
+    return itr;
+}
+
 //--------------------------------------------------------------------------------------//
 //
 template <typename Type>
@@ -34,6 +34,7 @@
 #include "timemory/operations/types/cleanup.hpp"
 #include "timemory/operations/types/set.hpp"
 #include "timemory/storage/base_storage.hpp"
+#include "timemory/storage/call_graph_index.hpp"
 #include "timemory/storage/graph.hpp"
 #include "timemory/storage/graph_data.hpp"
 #include "timemory/storage/impl_storage_deleter.hpp"
@@ -99,6 +100,7 @@ public:
     using secondary_data_t       = std::tuple<iterator, const std::string&, Vp>;
     using iterator_hash_submap_t = uomap_t<int64_t, iterator>;
     using iterator_hash_map_t    = uomap_t<int64_t, iterator_hash_submap_t>;
+    using dense_index_t          = call_graph_index<iterator>;
 
     friend class tim::manager;
     friend struct node::result<Type>;
@@ -232,6 +234,8 @@ protected:
                          int64_t _tid);
     iterator insert_hierarchy(uint64_t hash_id, const Type& obj, uint64_t hash_depth,
                               bool has_head, int64_t _tid);
+    iterator insert_dense(uint64_t hash_id, uint64_t hash_value, const Type& obj,
+                          uint64_t hash_depth, int64_t _tid);
 
     void     merge();
     void     merge(this_type* itr);
@@ -257,6 +261,7 @@ private:
     mutable graph_data_t*      m_graph_data_instance = nullptr;
     std::shared_ptr<printer_t> m_printer             = {};
     iterator_hash_map_t        m_node_ids            = {};
+    dense_index_t              m_dense_index         = {};
     std::unordered_set<Type*>  m_stack               = {};
     sample_array_t             m_samples             = {};
 };
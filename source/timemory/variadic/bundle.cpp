@@ -30,6 +30,7 @@
 #endif
 
 #include "timemory/backends/dmp.hpp"
+#include "timemory/backends/procfs.hpp"
 #include "timemory/components/properties.hpp"
 #include "timemory/mpl/filters.hpp"
 #include "timemory/operations/types/set.hpp"
@@ -514,7 +515,10 @@ bundle<Tag, BundleT, TupleT>::start(mpl::lightweight, Args&&... args)
         return get_this_type();
 
     assemble(*this);
-    invoke::start<Tag>(m_data, std::forward<Args>(args)...);
+    {
+        procfs::coalesce_t<type_list_type> _coalesce{};
+        invoke::start<Tag>(m_data, std::forward<Args>(args)...);
+    }
     m_is_active(true);
     return get_this_type();
 }
@@ -529,7 +533,10 @@ bundle<Tag, BundleT, TupleT>::stop(mpl::lightweight, Args&&... args)
     if(!m_enabled())
         return get_this_type();
 
-    invoke::stop<Tag>(m_data, std::forward<Args>(args)...);
+    {
+        procfs::coalesce_t<type_list_type> _coalesce{};
+        invoke::stop<Tag>(m_data, std::forward<Args>(args)...);
+    }
     if(m_is_active())
         ++m_laps;
     derive(*this);
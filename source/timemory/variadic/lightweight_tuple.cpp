@@ -27,6 +27,7 @@
 
 #include "timemory/variadic/lightweight_tuple.hpp"
 
+#include "timemory/backends/procfs.hpp"
 #include "timemory/mpl/filters.hpp"
 #include "timemory/operations/types/set.hpp"
 #include "timemory/utility/macros.hpp"
@@ -309,7 +310,10 @@ template <typename... Args>
 lightweight_tuple<Types...>&
 lightweight_tuple<Types...>::start(Args&&... args)
 {
-    invoke::start(m_data, std::forward<Args>(args)...);
+    {
+        procfs::coalesce_t<type_list_type> _coalesce{};
+        invoke::start(m_data, std::forward<Args>(args)...);
+    }
     m_is_active(true);
     return get_this_type();
 }
@@ -350,7 +354,10 @@ template <typename... Args>
 lightweight_tuple<Types...>&
 lightweight_tuple<Types...>::stop(Args&&... args)
 {
-    invoke::stop(m_data, std::forward<Args>(args)...);
+    {
+        procfs::coalesce_t<type_list_type> _coalesce{};
+        invoke::stop(m_data, std::forward<Args>(args)...);
+    }
     ++m_laps;
     m_is_active(false);
     return get_this_type();
@@ -29,6 +29,7 @@
 #include "timemory/trace.hpp"
 
 #include "timemory/compat/library.h"
+#include "timemory/hash/flat_map.hpp"
 #include "timemory/library.h"
 #include "timemory/runtime/configure.hpp"
 #include "timemory/timemory.hpp"
@@ -40,56 +41,308 @@
 
 #include <cstdarg>
 #include <cstdlib>
+#include <algorithm>
 #include <deque>
 #include <iostream>
-#include <unordered_map>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
 
 using namespace tim::component;
 
-using string_t       = std::string;
-using overhead_map_t = std::unordered_map<size_t, std::pair<wall_clock, size_t>>;
-using throttle_set_t = std::set<size_t>;
-using traceset_t     = tim::component_bundle<TIMEMORY_API, user_trace_bundle>;
-using trace_map_t    = std::unordered_map<size_t, std::deque<traceset_t>>;
+using string_t   = std::string;
+using traceset_t = tim::component_bundle<TIMEMORY_API, user_trace_bundle>;
 
 //======================================================================================//
 
 static std::atomic<uint32_t> library_trace_count{ 0 };
 
 //--------------------------------------------------------------------------------------//
+//
+/// per-thread state of a traced call-site. Once the average runtime of throttle_count
+/// recorded calls is less than throttle_value, the call-site is throttled: calls are
+/// no longer recorded and only one out of every `stride` calls is timed. The stride
+/// doubles (up to throttle_max_stride) after every throttle_count timed calls whose
+/// average remains below throttle_value and the call-site is re-admitted, i.e.
+/// recorded again, as soon as the average of the timed calls exceeds throttle_value.
+///
+struct trace_site
+{
+    enum mode : uint8_t
+    {
+        skipped = 0,
+        timed,
+        recorded
+    };
 
-static auto&
-get_overhead() TIMEMORY_VISIBILITY("default");
-static auto&
-get_throttle() TIMEMORY_VISIBILITY("default");
-static trace_map_t&
-get_trace_map() TIMEMORY_VISIBILITY("default");
+    struct entry
+    {
+        int64_t start = 0;
+        mode    state = skipped;
+    };
+
+    static int64_t now() { return tim::get_clock_real_now<int64_t, std::nano>(); }
+
+    uint64_t               hash         = 0;
+    bool                   throttled    = false;
+    uint64_t               stride       = 1;
+    uint64_t               phase        = 0;
+    size_t                 window_count = 0;
+    int64_t                window_accum = 0;
+    uint64_t               ncalls       = 0;
+    uint64_t               nrecorded    = 0;
+    uint64_t               nthrottled   = 0;
+    uint64_t               nreadmitted  = 0;
+    int64_t                overhead     = 0;  // time spent starting/stopping traces
+    std::vector<entry>     stack        = {};
+    std::deque<traceset_t> traces       = {};
+};
 
 //--------------------------------------------------------------------------------------//
+//
+/// accumulated throttling statistics of the threads which have exited
+struct trace_site_summary
+{
+    uint64_t ncalls      = 0;
+    uint64_t nrecorded   = 0;
+    uint64_t nthrottled  = 0;
+    uint64_t nreadmitted = 0;
+    uint64_t nthreads    = 0;
+    int64_t  overhead    = 0;
+    double   saved       = 0.0;
+
+    trace_site_summary& operator+=(const trace_site& rhs)
+    {
+        ncalls += rhs.ncalls;
+        nrecorded += rhs.nrecorded;
+        nthrottled += rhs.nthrottled;
+        nreadmitted += rhs.nreadmitted;
+        nthreads += (rhs.nthrottled > 0) ? 1 : 0;
+        overhead += rhs.overhead;
+        // the calls which were not recorded are estimated to have saved the average
+        // cost of starting and stopping a trace on this thread
+        if(rhs.nrecorded > 0)
+            saved += static_cast<double>(rhs.ncalls - rhs.nrecorded) * rhs.overhead /
+                     rhs.nrecorded;
+        return *this;
+    }
+};
+
+using trace_summary_t = std::map<size_t, trace_site_summary>;
+
+static trace_summary_t&
+get_trace_summary()
+{
+    static trace_summary_t _instance{};
+    return _instance;
+}
 
-static auto&
-get_overhead()
+static std::mutex&
+get_trace_summary_mutex()
 {
-    static thread_local auto _instance = std::make_unique<overhead_map_t>();
+    static std::mutex _instance{};
     return _instance;
 }
 
 //--------------------------------------------------------------------------------------//
+//
+/// the call-sites of a thread are stored contiguously and indexed by a small site id
+/// which is looked up from the hash in an open-addressed table
+struct trace_site_table
+{
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    trace_site_table()  = default;
+    ~trace_site_table() { summarize(); }
+
+    trace_site_table(const trace_site_table&) = delete;
+    trace_site_table(trace_site_table&&)      = delete;
+    trace_site_table& operator=(const trace_site_table&) = delete;
+    trace_site_table& operator=(trace_site_table&&) = delete;
+
+    uint32_t find(uint64_t _hash) const
+    {
+        auto itr = m_index.find(_hash);
+        return (itr == m_index.end()) ? npos : itr->second;
+    }
+
+    uint32_t emplace(uint64_t _hash)
+    {
+        auto itr = m_index.emplace(_hash, static_cast<uint32_t>(m_sites.size()));
+        if(itr.second)
+        {
+            m_sites.emplace_back();
+            m_sites.back().hash = _hash;
+        }
+        return itr.first->second;
+    }
 
-static auto&
-get_throttle()
+    trace_site* get(uint64_t _hash)
+    {
+        auto _idx = find(_hash);
+        return (_idx == npos) ? nullptr : &m_sites[_idx];
+    }
+
+    trace_site& operator[](uint32_t _idx) { return m_sites[_idx]; }
+
+    auto begin() { return m_sites.begin(); }
+    auto end() { return m_sites.end(); }
+    bool empty() const { return m_sites.empty(); }
+
+    /// moves the throttling statistics into the process-wide summary
+    void summarize()
+    {
+        std::unique_lock<std::mutex> _lk{ get_trace_summary_mutex() };
+        auto&                        _summary = get_trace_summary();
+        for(auto& itr : m_sites)
+        {
+            if(itr.nthrottled > 0)
+                _summary[itr.hash] += itr;
+            itr.ncalls      = 0;
+            itr.nrecorded   = 0;
+            itr.nthrottled  = 0;
+            itr.nreadmitted = 0;
+            itr.overhead    = 0;
+        }
+    }
+
+private:
+    tim::hash::flat_map<uint32_t> m_index = {};
+    std::vector<trace_site>       m_sites = {};
+};
+
+//--------------------------------------------------------------------------------------//
+
+static trace_site_table&
+get_trace_sites() TIMEMORY_VISIBILITY("default");
+
+//--------------------------------------------------------------------------------------//
+
+static trace_site_table&
+get_trace_sites()
 {
-    static thread_local auto _instance = std::make_unique<throttle_set_t>();
+    static thread_local trace_site_table _instance;
     return _instance;
 }
 
 //--------------------------------------------------------------------------------------//
 
-static trace_map_t&
-get_trace_map()
+static size_t
+get_throttle_max_stride()
 {
-    static thread_local trace_map_t _instance;
-    return _instance;
+    return std::max<size_t>(tim::settings::throttle_max_stride(), 1);
+}
+
+//--------------------------------------------------------------------------------------//
+// updates the throttling state of the call-site after a call was timed
+//
+static void
+update_throttle(trace_site& _site, int64_t _elapsed)
+{
+    _site.window_accum += _elapsed;
+    if(++_site.window_count < tim::settings::throttle_count())
+        return;
+
+    auto _count = _site.window_count;
+    auto _accum = static_cast<size_t>(std::max<int64_t>(_site.window_accum, 0)) / _count;
+    _site.window_count = 0;
+    _site.window_accum = 0;
+
+    auto _get_name = [&_site]() {
+        auto itr = tim::get_hash_ids()->find(_site.hash);
+        return (itr != tim::get_hash_ids()->end()) ? itr->second : string_t{ "unknown" };
+    };
+
+    if(_accum < tim::settings::throttle_value())
+    {
+        if(!_site.throttled)
+        {
+            if(tim::settings::debug() || tim::settings::verbose() > 0)
+            {
+                fprintf(stderr,
+                        "[timemory-trace]> Throttling future calls to '%s' on rank = %i, "
+                        "pid = %i, thread = %i. avg runtime = %lu ns from %lu "
+                        "invocations... Consider eliminating from instrumentation...\n",
+                        _get_name().c_str(), tim::dmp::rank(),
+                        (int) tim::process::get_id(), (int) tim::threading::get_id(),
+                        (unsigned long) _accum, (unsigned long) _count);
+            }
+            _site.throttled = true;
+            _site.stride    = std::min<size_t>(2, get_throttle_max_stride());
+            ++_site.nthrottled;
+        }
+        else
+        {
+            // exponential back-off of the timed calls
+            _site.stride = std::min<size_t>(2 * _site.stride, get_throttle_max_stride());
+        }
+    }
+    else if(_site.throttled)
+    {
+        if(tim::settings::debug() || tim::settings::verbose() > 0)
+        {
+            fprintf(stderr,
+                    "[timemory-trace]> Re-admitting calls to '%s' on rank = %i, pid = %i, "
+                    "thread = %i. avg runtime = %lu ns from %lu timed invocations...\n",
+                    _get_name().c_str(), tim::dmp::rank(), (int) tim::process::get_id(),
+                    (int) tim::threading::get_id(), (unsigned long) _accum,
+                    (unsigned long) _count);
+        }
+        _site.throttled = false;
+        _site.stride    = 1;
+        _site.phase     = 0;
+        ++_site.nreadmitted;
+    }
+    else if(_accum < (10 * tim::settings::throttle_value()) &&
+            (tim::settings::debug() || tim::settings::verbose() > 1))
+    {
+        fprintf(stderr,
+                "[timemory-trace]> Warning! function call '%s' within an order of "
+                "magnitude of threshold for throttling value on rank = %i, pid = %i, "
+                "thread = %i. avg runtime = %lu ns from %lu invocations... Consider "
+                "eliminating from instrumentation...\n",
+                _get_name().c_str(), tim::dmp::rank(), (int) tim::process::get_id(),
+                (int) tim::threading::get_id(), (unsigned long) _accum,
+                (unsigned long) _count);
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+// reports the call-sites which were throttled and the estimated overhead saved
+//
+static void
+report_throttle()
+{
+    get_trace_sites().summarize();
+
+    std::unique_lock<std::mutex> _lk{ get_trace_summary_mutex() };
+    auto&                        _summary = get_trace_summary();
+    if(_summary.empty() || (!tim::settings::debug() && tim::settings::verbose() < 1))
+        return;
+
+    double _total = 0.0;
+    for(const auto& itr : _summary)
+        _total += itr.second.saved;
+
+    fprintf(stderr,
+            "[timemory-trace]> %lu call-sites were throttled on rank = %i, pid = %i. "
+            "estimated overhead saved = %.3f msec\n",
+            (unsigned long) _summary.size(), tim::dmp::rank(),
+            (int) tim::process::get_id(), _total * 1.0e-6);
+    fprintf(stderr, "[timemory-trace]> %12s %12s %10s %10s %8s %14s  %s\n", "calls",
+            "recorded", "throttled", "readmitted", "threads", "saved (msec)", "name");
+    for(const auto& itr : _summary)
+    {
+        auto _name = tim::get_hash_ids()->find(itr.first);
+        fprintf(stderr, "[timemory-trace]> %12lu %12lu %10lu %10lu %8lu %14.3f  %s\n",
+                (unsigned long) itr.second.ncalls, (unsigned long) itr.second.nrecorded,
+                (unsigned long) itr.second.nthrottled,
+                (unsigned long) itr.second.nreadmitted,
+                (unsigned long) itr.second.nthreads, itr.second.saved * 1.0e-6,
+                (_name != tim::get_hash_ids()->end()) ? _name->second.c_str()
+                                                      : "unknown");
+    }
 }
 
 //--------------------------------------------------------------------------------------//
@@ -373,18 +626,23 @@ extern "C"
     //
     bool timemory_is_throttled(const char* name)
     {
-        size_t _id = tim::get_hash_id(name);
-        return (get_throttle()->count(_id) > 0);
+        auto* _site = get_trace_sites().get(tim::get_hash_id(name));
+        return (_site && _site->throttled);
     }
     //
     //----------------------------------------------------------------------------------//
     //
     void timemory_reset_throttle(const char* name)
     {
-        size_t _id = tim::get_hash_id(name);
-        auto   itr = get_throttle()->find(_id);
-        if(itr != get_throttle()->end())
-            get_throttle()->erase(itr);
+        auto* _site = get_trace_sites().get(tim::get_hash_id(name));
+        if(_site)
+        {
+            _site->throttled    = false;
+            _site->stride       = 1;
+            _site->phase        = 0;
+            _site->window_count = 0;
+            _site->window_accum = 0;
+        }
     }
     //
     //----------------------------------------------------------------------------------//
@@ -477,24 +735,41 @@ extern "C"
             return;
         }
 
-        if(get_throttle()->count(id) > 0)
+        auto& _sites = get_trace_sites();
+        auto  _idx   = _sites.find(id);
+        if(_idx == trace_site_table::npos)
+        {
+            if(tim::get_hash_ids()->find(id) == tim::get_hash_ids()->end())
+                return;
+            _idx = _sites.emplace(id);
+        }
+
+        auto& _site = _sites[_idx];
+        ++_site.ncalls;
+
+        if(_site.throttled)
         {
 #if defined(DEBUG) || !defined(NDEBUG)
             if(tim::settings::debug())
                 TIMEMORY_PRINT_HERE("trace %llu is throttled", (unsigned long long) id);
 #endif
+            // only time one out of every stride calls
+            if(++_site.phase < _site.stride)
+            {
+                _site.stack.emplace_back(trace_site::entry{ 0, trace_site::skipped });
+            }
+            else
+            {
+                _site.phase = 0;
+                _site.stack.emplace_back(
+                    trace_site::entry{ trace_site::now(), trace_site::timed });
+            }
             return;
         }
 
-        auto& _trace_map = get_trace_map();
-        auto& _overh_map = *get_overhead();
-
-        if(tim::get_hash_ids()->find(id) == tim::get_hash_ids()->end())
-            return;
-
         if(tim::settings::debug())
         {
-            int64_t  n    = _trace_map[id].size();
+            int64_t  n    = _site.traces.size();
             auto     itr  = tim::get_hash_ids()->find(id);
             string_t name = (itr != tim::get_hash_ids()->end()) ? itr->second : "unknown";
             fprintf(stderr,
@@ -515,9 +790,12 @@ extern "C"
             _bmtx.unlock();
         }
 
-        _trace_map[id].emplace_back(traceset_t{ id });
-        _trace_map[id].back().start();
-        _overh_map[id].first.start();
+        auto _beg = trace_site::now();
+        _site.traces.emplace_back(traceset_t{ id });
+        _site.traces.back().start();
+        auto _end = trace_site::now();
+        _site.overhead += _end - _beg;
+        _site.stack.emplace_back(trace_site::entry{ _end, trace_site::recorded });
     }
     //
     //----------------------------------------------------------------------------------//
@@ -528,10 +806,10 @@ extern "C"
         if(!get_library_state()[0] || get_library_state()[1])
             return;
 
-        auto& _trace_map = get_trace_map();
-        if(!tim::settings::enabled() && _trace_map.empty())
+        auto& _sites = get_trace_sites();
+        if(!tim::settings::enabled() && _sites.empty())
         {
-            if(tim::settings::debug() && _trace_map.empty())
+            if(tim::settings::debug())
                 fprintf(stderr,
                         "[timemory-trace]> timemory_pop_trace_hash(%lu) failed. "
                         "trace_map empty...\n",
@@ -539,79 +817,44 @@ extern "C"
             return;
         }
 
-        int64_t ntotal = _trace_map[id].size();
-        int64_t offset = ntotal - 1;
-
-        if(tim::settings::debug())
-        {
-            auto     itr  = tim::get_hash_ids()->find(id);
-            string_t name = (itr != tim::get_hash_ids()->end()) ? itr->second : "unknown";
-            fprintf(stderr,
-                    "ending trace for '%s' (id = %llu, offset = %lli, rank = %i, pid = "
-                    "%i, thread = %i)...\n",
-                    name.c_str(), (long long unsigned) id, (long long int) offset,
-                    tim::dmp::rank(), (int) tim::process::get_id(),
-                    (int) tim::threading::get_id());
-        }
+        auto* _site = _sites.get(id);
 
-        (*get_overhead())[id].first.stop();
-
-        // if there were no entries, return (pop called without a push)
-        if(offset < 0)
+        // pop called without a push
+        if(!_site || _site->stack.empty())
             return;
 
-        if(offset >= 0 && ntotal > 0)
-        {
-            _trace_map[id].back().stop();
-            _trace_map[id].pop_back();
-        }
+        auto _end   = trace_site::now();
+        auto _entry = _site->stack.back();
+        _site->stack.pop_back();
 
-        if(get_throttle() && get_throttle()->count(id) > 0)
+        if(_entry.state == trace_site::skipped)
             return;
 
-        auto _count = ++(get_overhead()->at(id).second);
-
-        if(_count % tim::settings::throttle_count() == 0)
+        if(_entry.state == trace_site::recorded)
         {
-            auto _accum = get_overhead()->at(id).first.get_accum() / _count;
-            if(_accum < tim::settings::throttle_value())
+            if(tim::settings::debug())
             {
-                if(tim::settings::debug() || tim::settings::verbose() > 0)
-                {
-                    auto name = tim::get_hash_ids()->find(id)->second;
-                    fprintf(
-                        stderr,
-                        "[timemory-trace]> Throttling all future calls to '%s' on rank = "
-                        "%i, pid = "
-                        "%i, thread = %i. avg runtime = %lu ns from %lu invocations... "
-                        "Consider eliminating from instrumentation...\n",
-                        name.c_str(), tim::dmp::rank(), (int) tim::process::get_id(),
-                        (int) tim::threading::get_id(), (unsigned long) _accum,
-                        (unsigned long) _count);
-                }
-                get_throttle()->insert(id);
+                auto     itr  = tim::get_hash_ids()->find(id);
+                string_t name =
+                    (itr != tim::get_hash_ids()->end()) ? itr->second : "unknown";
+                fprintf(stderr,
+                        "ending trace for '%s' (id = %llu, offset = %lli, rank = %i, "
+                        "pid = %i, thread = %i)...\n",
+                        name.c_str(), (long long unsigned) id,
+                        (long long int) _site->traces.size() - 1, tim::dmp::rank(),
+                        (int) tim::process::get_id(), (int) tim::threading::get_id());
             }
-            else
+
+            if(!_site->traces.empty())
             {
-                if(_accum < (10 * tim::settings::throttle_value()) &&
-                   (tim::settings::debug() || tim::settings::verbose() > 1))
-                {
-                    auto name = tim::get_hash_ids()->find(id)->second;
-                    fprintf(
-                        stderr,
-                        "[timemory-trace]> Warning! function call '%s' within an order "
-                        "of magnitude of threshold for throttling value on rank = %i, "
-                        "pid = "
-                        "%i, thread = %i. avg runtime = %lu ns from %lu invocations... "
-                        "Consider eliminating from instrumentation...\n",
-                        name.c_str(), tim::dmp::rank(), (int) tim::process::get_id(),
-                        (int) tim::threading::get_id(), (unsigned long) _accum,
-                        (unsigned long) _count);
-                }
+                _site->traces.back().stop();
+                _site->traces.pop_back();
             }
-            get_overhead()->at(id).first.reset();
-            get_overhead()->at(id).second = 0;
+            ++_site->nrecorded;
+            _site->overhead += trace_site::now() - _end;
         }
+
+        update_throttle(*_site, _end - _entry.start);
     }
     //
     //----------------------------------------------------------------------------------//
@@ -865,18 +1108,19 @@ extern "C"
         if(!_skip_stop)
         {
             TIMEMORY_CONDITIONAL_PRINT_HERE(_debug, "%s", "cleaning trace map");
-            for(auto& itr : get_trace_map())
+            for(auto& itr : get_trace_sites())
             {
-                for(auto& eitr : itr.second)
+                for(auto& eitr : itr.traces)
                     eitr.stop();
                 // delete all the records
-                itr.second.clear();
+                itr.traces.clear();
+                itr.stack.clear();
             }
-            TIMEMORY_CONDITIONAL_PRINT_HERE(_debug, "%s", "clearing trace map");
-            // delete all the records
-            get_trace_map().clear();
         }
 
+        TIMEMORY_CONDITIONAL_PRINT_HERE(_debug, "%s", "reporting throttled traces");
+        report_throttle();
+
         TIMEMORY_CONDITIONAL_PRINT_HERE(_debug, "%s", "resetting mpi gotcha");
         // deactivate the gotcha wrappers
         if(use_mpi_gotcha)